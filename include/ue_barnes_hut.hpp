@@ -0,0 +1,84 @@
+// ue_barnes_hut.hpp
+// AMOURANTH RTX Engine, October 2025 - Barnes-Hut gravity solver for UniversalEquation.
+// Builds a k-d tree over the active coordinate planes and approximates distant vertex groups by their
+// centre of mass, reducing the gravitational acceleration pass from O(N^2) to O(N log N).
+// A 2^d-ary tree is impractical at up to 19 dimensions, so a median-split k-d tree is used for every d.
+// Dependencies: OpenMP, ue_vertex_store.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_BARNES_HUT_HPP
+#define UE_BARNES_HUT_HPP
+
+#include "ue_vertex_store.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace UE {
+
+// Gravitational acceleration solver used by UniversalEquationT::updateMomentum
+enum class GravitySolver {
+    Exact,        // All-pairs O(N^2) reference path
+    BarnesHut,    // Tree approximation controlled by the opening angle
+    ParticleMesh  // FFT mesh over the first three coordinates, resolution set by meshGridSize
+};
+
+template<typename Real, typename Accum = Real>
+class BarnesHutTree {
+public:
+    static constexpr int kMaxDimensions = 19;
+    static constexpr std::size_t kLeafSize = 16;
+    // Subtrees smaller than this are built on the spawning thread instead of as an OpenMP task
+    static constexpr std::size_t kTaskThreshold = 4096;
+
+    // Throws std::length_error when count exceeds the 32-bit node index range
+    static void checkCapacity(std::size_t count);
+
+    // Rebuilds the tree over the first `dimensions` planes of positions
+    void build(const VertexStore<Real>& positions, int dimensions);
+
+    // Fills out (resized to positions.size() x dimensions()) with the acceleration on every vertex.
+    // A node is approximated when the vertex lies outside its bounds and size < openingAngle * distance;
+    // openingAngle = 0 degenerates to the exact sum.
+    void computeAccelerations(const VertexStore<Real>& positions, Accum influence, Accum openingAngle,
+                              VertexStore<Accum>& out) const;
+
+    // Worksharing variants of build/computeAccelerations for callers that already own a parallel region.
+    // Every thread of the team must reach them; called outside a region they run serially.
+    // checkCapacity must have passed beforehand since exceptions cannot leave the region.
+    void buildTeam(const VertexStore<Real>& positions, int dimensions);
+    void computeAccelerationsTeam(const VertexStore<Real>& positions, Accum influence, Accum openingAngle,
+                                  VertexStore<Accum>& out) const;
+
+    std::size_t nodeCount() const { return nodes_.size(); }
+    int dimensions() const { return dims_; }
+    bool empty() const { return nodes_.empty(); }
+
+private:
+    struct Node {
+        std::uint32_t begin;  // Range into order_
+        std::uint32_t end;
+        std::int32_t right;   // Right child; the left child is always the next node, -1 marks a leaf
+        Accum size;           // Longest bounding-box side
+    };
+
+    static std::size_t countNodes(std::size_t count);
+    // Per-vertex traversal of computeAccelerationsTeam, instantiated per dimension count (0 = runtime count)
+    template<int Dims>
+    void traverseTeam(Accum influence, Accum theta2, VertexStore<Accum>& out) const;
+    void buildNode(const VertexStore<Real>& positions, std::size_t node, std::size_t begin, std::size_t end);
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> order_;
+    std::vector<Accum> centers_;  // node * dims_ + j
+    std::vector<Accum> lower_;
+    std::vector<Accum> upper_;
+    std::vector<Accum> sorted_;   // Coordinates in tree order, plane-major: j * count + p
+    int dims_ = 0;
+};
+
+} // namespace UE
+
+#endif // UE_BARNES_HUT_HPP
@@ -0,0 +1,123 @@
+// ue_checkpoint.hpp
+// AMOURANTH RTX Engine, October 2025 - Binary checkpoint format for UniversalEquation.
+// A versioned header followed by sections aligned for mapping: parameters, then the position and momentum planes
+// in VertexStore layout and the spin and amplitude arrays. Uncompressed sections can be mapped straight into
+// a VertexStore; compressed ones (LZ4 or Zstd, when built in) are split into chunks that compress and
+// decompress in parallel. Every section and the header carry a 64-bit checksum.
+// Dependencies: OpenMP, ue_mapped_storage.hpp, C++20 standard library; optionally liblz4 and libzstd.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_CHECKPOINT_HPP
+#define UE_CHECKPOINT_HPP
+
+#include "ue_mapped_storage.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace UE {
+
+enum class CheckpointCompression : std::uint32_t {
+    None = 0,
+    LZ4 = 1, // Needs a build with UE_HAVE_LZ4
+    Zstd = 2 // Needs a build with UE_HAVE_ZSTD
+};
+
+struct CheckpointOptions {
+    CheckpointCompression compression = CheckpointCompression::None;
+    int level = 3; // Zstd compression level; LZ4 ignores it
+};
+
+inline constexpr std::uint64_t kCheckpointMagic = 0x313054504b434555ULL; // "UECKPT01" in file byte order
+inline constexpr std::uint32_t kCheckpointVersion = 1;
+// Sections start on this boundary so each can be mapped on its own
+inline constexpr std::size_t kCheckpointAlignment = kFileMappingAlignment;
+// Uncompressed bytes per compression chunk
+inline constexpr std::size_t kCheckpointChunk = std::size_t(16) << 20;
+
+enum CheckpointSection : std::uint32_t {
+    kCheckpointParams,
+    kCheckpointPositions,
+    kCheckpointMomenta,
+    kCheckpointSpins,
+    kCheckpointAmplitudes,
+    kCheckpointSections
+};
+
+struct CheckpointSectionEntry {
+    std::uint64_t offset;      // From the start of the file, a multiple of kCheckpointAlignment
+    std::uint64_t storedBytes; // On disk, including the chunk table when compressed
+    std::uint64_t rawBytes;    // After decompression
+    std::uint64_t checksum;    // Of the stored bytes
+};
+
+struct CheckpointHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t compression; // CheckpointCompression
+    std::uint32_t realBytes;   // sizeof(Real) of the planes and arrays
+    std::uint32_t accumBytes;  // sizeof(Accum) of the parameters
+    std::uint32_t paramsBytes; // sizeof(Params<Accum>)
+    std::int32_t maxDimensions;
+    std::int32_t currentDimension;
+    std::int32_t mode;
+    std::uint64_t vertexCount;
+    std::uint64_t planeStride; // Elements between planes of the position and momentum sections
+    double simulationTime;
+    std::array<CheckpointSectionEntry, kCheckpointSections> sections;
+    std::uint64_t headerChecksum; // Of every byte above
+};
+
+// Deterministic 64-bit checksum; large inputs are hashed in parallel blocks
+std::uint64_t checkpointChecksum(const void* data, std::size_t bytes) noexcept;
+
+// The chunked codec of compressed sections, shared with other binary writers. compressChunks() throws
+// std::invalid_argument for a codec this build lacks; decompressChunks() throws std::runtime_error when stored
+// is not a valid encoding of exactly out.size() bytes.
+bool compressionAvailable(CheckpointCompression codec) noexcept;
+std::vector<std::byte> compressChunks(CheckpointCompression codec, int level, std::span<const std::byte> raw);
+void decompressChunks(CheckpointCompression codec, std::span<const std::byte> stored, std::span<std::byte> out);
+
+// Writes header and sections to path. The file is written beside it and renamed into place, so a crash never
+// leaves a truncated checkpoint under the final name. Section offsets, sizes and checksums in the header are
+// filled in here.
+void writeCheckpoint(const std::string& path, CheckpointHeader header,
+                     const std::array<std::span<const std::byte>, kCheckpointSections>& sections,
+                     const CheckpointOptions& options);
+
+// Read-only view of a checkpoint file. Opening maps the file and validates the header; verify() checks the
+// section checksums.
+class CheckpointFile {
+public:
+    explicit CheckpointFile(const std::string& path);
+    ~CheckpointFile();
+    CheckpointFile(const CheckpointFile&) = delete;
+    CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+    const CheckpointHeader& header() const noexcept { return *header_; }
+    const std::string& path() const noexcept { return path_; }
+    bool compressed() const noexcept {
+        return header_->compression != static_cast<std::uint32_t>(CheckpointCompression::None);
+    }
+    // Throws std::runtime_error naming the first section whose checksum does not match
+    void verify() const;
+    // Stored bytes of a section, as mapped
+    std::span<const std::byte> stored(CheckpointSection section) const noexcept;
+    // Decompresses or copies a section into out, which must hold its rawBytes
+    void read(CheckpointSection section, std::span<std::byte> out) const;
+
+private:
+    std::string path_;
+    const std::byte* data_ = nullptr;
+    std::size_t bytes_ = 0;
+    const CheckpointHeader* header_ = nullptr;
+};
+
+} // namespace UE
+
+#endif // UE_CHECKPOINT_HPP
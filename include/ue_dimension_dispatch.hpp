@@ -0,0 +1,70 @@
+// ue_dimension_dispatch.hpp
+// AMOURANTH RTX Engine, October 2025 - Compile-time dimension specialization for UniversalEquation kernels.
+// Hot kernels are templated on their dimension count and instantiated for every count from 1 to 19, so the
+// per-pair coordinate loops have fixed trip counts the compiler can unroll and vectorize. Instance 0 keeps the
+// runtime count as a fallback. Callers pick an instance from a table built here, once per pass.
+// Dependencies: C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_DIMENSION_DISPATCH_HPP
+#define UE_DIMENSION_DISPATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace UE {
+
+// Largest dimension count with a dedicated instance
+inline constexpr int kDispatchDimensions = 19;
+
+template<int Dims>
+using DimensionConstant = std::integral_constant<int, Dims>;
+
+// Coordinate buffer size of an instance: exact when specialised, the maximum for the generic instance
+template<int Dims>
+inline constexpr std::size_t dimensionCapacity = Dims > 0 ? static_cast<std::size_t>(Dims)
+                                                          : static_cast<std::size_t>(kDispatchDimensions);
+
+// Loop bound inside an instance: the compile-time count, or the runtime one for the generic instance
+template<int Dims>
+constexpr std::size_t activeDimensions(std::size_t runtime) noexcept {
+    if constexpr (Dims > 0) {
+        return static_cast<std::size_t>(Dims);
+    } else {
+        return runtime;
+    }
+}
+
+// Table slot of a dimension count; counts outside [1, kDispatchDimensions] map to the generic slot 0
+constexpr std::size_t dimensionSlot(int dimensions) noexcept {
+    return dimensions >= 1 && dimensions <= kDispatchDimensions ? static_cast<std::size_t>(dimensions) : 0;
+}
+
+// {factory(DimensionConstant<0>{}), ..., factory(DimensionConstant<kDispatchDimensions>{})}; factory returns the
+// function pointer of the instance for each count
+template<typename Factory>
+constexpr auto makeDimensionTable(Factory factory) {
+    return [&]<int... D>(std::integer_sequence<int, D...>) {
+        return std::array{factory(DimensionConstant<D>{})...};
+    }(std::make_integer_sequence<int, kDispatchDimensions + 1>{});
+}
+
+// Calls f(DimensionConstant<dimensions>{}), or f(DimensionConstant<0>{}) outside [1, kDispatchDimensions], for
+// kernels written as generic lambdas
+template<typename F>
+void dispatchDimension(int dimensions, F&& f) {
+    [&]<int... D>(std::integer_sequence<int, D...>) {
+        const bool matched = ((dimensions == D + 1 ? (f(DimensionConstant<D + 1>{}), true) : false) || ...);
+        if (!matched) {
+            f(DimensionConstant<0>{});
+        }
+    }(std::make_integer_sequence<int, kDispatchDimensions>{});
+}
+
+} // namespace UE
+
+#endif // UE_DIMENSION_DISPATCH_HPP
@@ -0,0 +1,95 @@
+// ue_export.hpp
+// AMOURANTH RTX Engine, October 2025 - Result export for UniversalEquation.
+// Streams rows of fixed-layout results to CSV, formatted with std::to_chars into a large buffer, or to the Arrow
+// IPC streaming format (little-endian Int32 and Float64 columns, readable by pyarrow.ipc.open_stream and other
+// Arrow readers). Both formats can append to an existing file of the same layout, so successive sweeps stream
+// into one file.
+// Dependencies: C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_EXPORT_HPP
+#define UE_EXPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace UE {
+
+enum class ExportFormat {
+    Csv,
+    ArrowStream // Arrow IPC streaming format, one record batch per batchRows rows
+};
+
+enum class ExportMode {
+    Truncate,
+    Append // Adds rows to an existing file, which must have the same columns; a missing file is created
+};
+
+enum class ExportType : std::uint8_t { Int32, Float64 };
+
+struct ExportColumn {
+    std::string name;
+    ExportType type = ExportType::Float64;
+};
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::Csv;
+    ExportMode mode = ExportMode::Truncate;
+    int precision = 10;                                // CSV digits after the point; negative for shortest round-trip
+                                                       // (of the double, for values a double holds exactly)
+    std::size_t batchRows = 65536;                     // Rows per Arrow record batch
+    std::size_t bufferBytes = std::size_t(1) << 20;    // CSV text buffered before each write
+};
+
+// Writes rows one value at a time, in column order. Float64 columns take long double values at full precision in
+// CSV and narrowed to double in Arrow. Not thread-safe.
+class ResultWriter {
+public:
+    ResultWriter(const std::string& path, std::vector<ExportColumn> columns, const ExportOptions& options = {});
+    ~ResultWriter();
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Each call fills the next column of the current row; the type must match the column
+    void value(std::int32_t v);
+    void value(double v) { value(static_cast<long double>(v)); }
+    void value(long double v);
+    // Completes the row; throws std::logic_error when columns are missing
+    void endRow();
+    // Writes buffered CSV text, or the pending rows as a record batch
+    void flush();
+    // Flushes and, for Arrow, writes the end-of-stream marker. Idempotent.
+    void close();
+
+    const std::vector<ExportColumn>& columns() const noexcept { return columns_; }
+    std::uint64_t rows() const noexcept { return rows_; }
+
+private:
+    void checkColumn(ExportType type) const;
+    void putText(char c);
+    void flushText();
+    void writeRecordBatch();
+    std::vector<std::byte> schemaMessage() const;
+
+    std::string path_;
+    std::vector<ExportColumn> columns_;
+    ExportOptions options_;
+    std::ofstream file_;
+    std::size_t column_ = 0; // Next column of the current row
+    std::uint64_t rows_ = 0;
+    bool closed_ = false;
+    std::vector<char> text_;                        // CSV: buffer of formatted text
+    std::size_t textUsed_ = 0;                      // CSV: bytes of text_ not yet written
+    std::size_t pendingRows_ = 0;                   // Arrow: rows in the batch being built
+    std::vector<std::vector<std::int32_t>> ints_;   // Arrow: per-column values, used by Int32 columns
+    std::vector<std::vector<double>> doubles_;      // Arrow: per-column values, used by Float64 columns
+};
+
+} // namespace UE
+
+#endif // UE_EXPORT_HPP
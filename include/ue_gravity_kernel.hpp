@@ -0,0 +1,46 @@
+// ue_gravity_kernel.hpp
+// AMOURANTH RTX Engine, October 2025 - Exact all-pairs gravity kernel for UniversalEquation.
+// Tiles the vertex set into cache-sized blocks and evaluates every pair once, applying equal and opposite
+// contributions to both vertices. Inner loops use std::experimental::simd where available, scalar otherwise.
+// Dependencies: OpenMP, ue_vertex_store.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_GRAVITY_KERNEL_HPP
+#define UE_GRAVITY_KERNEL_HPP
+
+#include "ue_vertex_store.hpp"
+#include <array>
+#include <cstddef>
+
+namespace UE {
+
+template<typename Real, typename Accum = Real>
+class PairwiseGravityKernel {
+public:
+    static constexpr int kMaxDimensions = 19;
+    // Vertices per tile; two tiles of 19 long double planes still fit comfortably in L2
+    static constexpr std::size_t kTileSize = 128;
+
+    // Fills out (resized to positions.size() x dimensions) with the exact acceleration on every vertex.
+    // Tile pairs are scheduled in round-robin rounds so no two threads ever write the same tile, which keeps
+    // the summation order, and therefore the result, independent of the thread count.
+    void compute(const VertexStore<Real>& positions, int dimensions, Accum influence, VertexStore<Accum>& out);
+
+    // Worksharing variant for callers that already own a parallel region; every thread of the team must
+    // reach it. Called outside a region it runs serially.
+    void computeTeam(const VertexStore<Real>& positions, int dimensions, Accum influence, VertexStore<Accum>& out);
+
+private:
+    VertexStore<Accum> converted_; // Positions widened to Accum when Real differs
+    // Plane pointers published by the team's single section
+    std::array<const Accum*, kMaxDimensions> sources_{};
+    std::array<Accum*, kMaxDimensions> targets_{};
+    std::size_t count_ = 0;
+    std::size_t dims_ = 0;
+};
+
+} // namespace UE
+
+#endif // UE_GRAVITY_KERNEL_HPP
@@ -13,7 +13,26 @@
 #include <vulkan/vulkan.h>
 #include "engine/logging.hpp"
 #include "VulkanCore.hpp"
+#include "ue_vertex_store.hpp"
+#include "ue_interaction_store.hpp"
+#include "ue_shared_vector.hpp"
+#include "ue_barnes_hut.hpp"
+#include "ue_gravity_kernel.hpp"
+#include "ue_mean_field.hpp"
+#include "ue_particle_mesh.hpp"
+#include "ue_procedural_vertices.hpp"
+#include "ue_checkpoint.hpp"
+#include "ue_trajectory.hpp"
+#include "ue_export.hpp"
+#include "ue_integrator.hpp"
+#include "ue_params.hpp"
+#include "ue_potential_estimator.hpp"
+#include "ue_dimension_dispatch.hpp"
+#include "ue_reduction.hpp"
+#include "ue_sweep.hpp"
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <latch>
@@ -24,13 +43,26 @@
 #include <sstream>
 #include <fstream>
 #include <format>
+#include <functional>
+#include <future>
 #include <source_location>
+#include <span>
+#include <type_traits>
+#include <variant>
 
 class VulkanRenderer; // Forward declaration
 class AMOURANTH; // Forward declaration
 
 // Namespace for UniversalEquation-related structures
 namespace UE {
+    // Numeric precision of the simulation core, chosen when AMOURANTH is constructed
+    enum class Precision {
+        LongDouble, // long double storage and accumulation (x87 on x86, reference results)
+        Double,     // double storage and accumulation
+        Float,      // float storage and accumulation
+        Mixed       // float storage with double accumulation
+    };
+
     struct DimensionData {
         int dimension = 0;
         long double scale = 1.0L;
@@ -73,6 +105,8 @@ namespace UE {
         long double momentumEnergy = 0.0L;
         long double fieldEnergy = 0.0L;
         long double GodWaveEnergy = 0.0L;
+        long double potentialError = 0.0L; // Standard error of the sampled potential
+        int potentialRounds = 0;           // Refinement rounds the potential estimate used
 
         std::string toString() const {
             std::stringstream ss;
@@ -84,21 +118,69 @@ namespace UE {
                << ", spinEnergy=" << spinEnergy
                << ", momentumEnergy=" << momentumEnergy
                << ", fieldEnergy=" << fieldEnergy
-               << ", GodWaveEnergy=" << GodWaveEnergy << "}";
+               << ", GodWaveEnergy=" << GodWaveEnergy
+               << ", potentialError=" << potentialError
+               << ", potentialRounds=" << potentialRounds << "}";
             return ss.str();
         }
     };
 
-    struct DimensionInteraction {
-        int index;
-        long double distance;
-        long double strength;
-        std::vector<long double> vectorPotential;
-        long double godWaveAmplitude;
+    // Row layouts for UE::ResultWriter. DimensionData rows keep the exportToCSV columns; EnergyResult rows and
+    // SweepResults share one layout, led by the dimension. Writing from a computeBatch() callback streams each
+    // dimension out as it finishes.
+    inline std::vector<ExportColumn> dimensionDataColumns() {
+        return {{"Dimension", ExportType::Int32}, {"Scale"}, {"Observable"}, {"Potential"}, {"NURB_Matter"},
+                {"NURB_Energy"}, {"Spin_Energy"}, {"Momentum_Energy"}, {"Field_Energy"}, {"God_Wave_Energy"}};
+    }
 
-        DimensionInteraction(int idx, long double dist, long double str, std::vector<long double> vecPot, long double gwAmp)
-            : index(idx), distance(dist), strength(str), vectorPotential(std::move(vecPot)), godWaveAmplitude(gwAmp) {}
-    };
+    inline void writeRow(ResultWriter& writer, const DimensionData& d) {
+        writer.value(static_cast<std::int32_t>(d.dimension));
+        writer.value(d.scale);
+        writer.value(d.observable);
+        writer.value(d.potential);
+        writer.value(d.nurbMatter);
+        writer.value(d.nurbEnergy);
+        writer.value(d.spinEnergy);
+        writer.value(d.momentumEnergy);
+        writer.value(d.fieldEnergy);
+        writer.value(d.GodWaveEnergy);
+        writer.endRow();
+    }
+
+    inline std::vector<ExportColumn> energyResultColumns() {
+        return {{"Dimension", ExportType::Int32}, {"Observable"}, {"Potential"}, {"NURB_Matter"}, {"NURB_Energy"},
+                {"Spin_Energy"}, {"Momentum_Energy"}, {"Field_Energy"}, {"God_Wave_Energy"}, {"Potential_Error"}};
+    }
+
+    inline void writeRow(ResultWriter& writer, int dimension, const EnergyResult& r) {
+        writer.value(static_cast<std::int32_t>(dimension));
+        writer.value(r.observable);
+        writer.value(r.potential);
+        writer.value(r.nurbMatter);
+        writer.value(r.nurbEnergy);
+        writer.value(r.spinEnergy);
+        writer.value(r.momentumEnergy);
+        writer.value(r.fieldEnergy);
+        writer.value(r.GodWaveEnergy);
+        writer.value(r.potentialError);
+        writer.endRow();
+    }
+
+    inline void writeRows(ResultWriter& writer, const SweepResults& results) {
+        for (std::size_t n = 0; n < results.size(); ++n) {
+            writer.value(static_cast<std::int32_t>(results.dimension[n]));
+            writer.value(results.observable[n]);
+            writer.value(results.potential[n]);
+            writer.value(results.nurbMatter[n]);
+            writer.value(results.nurbEnergy[n]);
+            writer.value(results.spinEnergy[n]);
+            writer.value(results.momentumEnergy[n]);
+            writer.value(results.fieldEnergy[n]);
+            writer.value(results.GodWaveEnergy[n]);
+            writer.value(results.potentialError[n]);
+            writer.endRow();
+        }
+    }
 
     struct UniformBufferObject {
         glm::mat4 model;
@@ -135,111 +217,171 @@ private:
     uint64_t numVertices_ = 30000;
 };
 
-class UniversalEquation {
+// Simulation core templated over a precision policy: Real is the per-vertex storage type,
+// Accum is used for parameters, pair arithmetic and reductions (e.g. float storage with double accumulation).
+template<typename Real, typename Accum = Real>
+class UniversalEquationT {
+    static_assert(std::is_floating_point_v<Real> && std::is_floating_point_v<Accum>,
+                  "UniversalEquationT requires floating-point storage and accumulation types");
+    static_assert(sizeof(Accum) >= sizeof(Real), "Accumulation type must be at least as wide as storage type");
+
 public:
-    UniversalEquation(int maxDimensions, int mode, long double influence, long double weak, bool debug, uint64_t numVertices);
-    UniversalEquation(int maxDimensions, int mode, long double influence, long double weak, long double collapse,
-                     long double twoD, long double threeDInfluence, long double oneDPermeation,
-                     long double nurbMatterStrength, long double nurbEnergyStrength, long double alpha,
-                     long double beta, long double carrollFactor, long double meanFieldApprox,
-                     long double asymCollapse, long double perspectiveTrans, long double perspectiveFocal,
-                     long double spinInteraction, long double emFieldStrength, long double renormFactor,
-                     long double vacuumEnergy, long double godWaveFreq, bool debug, uint64_t numVertices);
-    UniversalEquation(const UniversalEquation& other);
-    UniversalEquation& operator=(const UniversalEquation& other);
-    ~UniversalEquation();
+    using value_type = Real;
+    using accum_type = Accum;
+
+    // numVertices above UE::maxVertices(storage) throws std::invalid_argument; a mapped storage lifts the heap cap
+    // of 1 << 20 vertices
+    UniversalEquationT(int maxDimensions, int mode, Accum influence, Accum weak, bool debug, uint64_t numVertices,
+                       const UE::VertexStorage& storage = {});
+    UniversalEquationT(int maxDimensions, int mode, Accum influence, Accum weak, Accum collapse,
+                       Accum twoD, Accum threeDInfluence, Accum oneDPermeation,
+                       Accum nurbMatterStrength, Accum nurbEnergyStrength, Accum alpha,
+                       Accum beta, Accum carrollFactor, Accum meanFieldApprox,
+                       Accum asymCollapse, Accum perspectiveTrans, Accum perspectiveFocal,
+                       Accum spinInteraction, Accum emFieldStrength, Accum renormFactor,
+                       Accum vacuumEnergy, Accum godWaveFreq, bool debug, uint64_t numVertices,
+                       const UE::VertexStorage& storage = {});
+    // Copies take other's parameters and lattice size and re-initialize the vertex state; fork() keeps it
+    UniversalEquationT(const UniversalEquationT& other);
+    UniversalEquationT& operator=(const UniversalEquationT& other);
+    // Moves transfer the whole state, including a running trajectory recording. The moved-from instance may only
+    // be assigned to or destroyed.
+    UniversalEquationT(UniversalEquationT&& other) noexcept;
+    UniversalEquationT& operator=(UniversalEquationT&& other) noexcept;
+    ~UniversalEquationT();
+    void swap(UniversalEquationT& other) noexcept;
+    friend void swap(UniversalEquationT& a, UniversalEquationT& b) noexcept { a.swap(b); }
+
+    // Independent instance in the same state, for what-if branches: advancing either one leaves the other as it
+    // was, and both produce the results this instance would have. Vertex arrays are shared copy-on-write, so the
+    // fork costs O(1) until one of them writes, and then only the arrays actually written are copied. Must not
+    // run concurrently with calls that modify this instance. The navigator and any trajectory recording stay
+    // with this instance.
+    UniversalEquationT fork() const;
+
+    // Parameter snapshot. Kernels take it once per call and pass it by const reference.
+    std::shared_ptr<const UE::Params<Accum>> getParams() const;
+    // Parameter transactions: setters called between beginUpdate() and the matching commit() edit a pending copy,
+    // and commit() publishes it once with a single invalidation. Transactions nest; only the outermost commit
+    // publishes. Setters outside a transaction publish immediately.
+    void beginUpdate();
+    void commit();
 
     // Getters
     int getCurrentDimension() const;
     int getMode() const;
     bool getDebug() const;
     uint64_t getMaxVertices() const;
+    const UE::VertexStorage& getVertexStorage() const;
     int getMaxDimensions() const;
-    long double getGodWaveFreq() const;
-    long double getInfluence() const;
-    long double getWeak() const;
-    long double getCollapse() const;
-    long double getTwoD() const;
-    long double getThreeDInfluence() const;
-    long double getOneDPermeation() const;
-    long double getNurbMatterStrength() const;
-    long double getNurbEnergyStrength() const;
-    long double getAlpha() const;
-    long double getBeta() const;
-    long double getCarrollFactor() const;
-    long double getMeanFieldApprox() const;
-    long double getAsymCollapse() const;
-    long double getPerspectiveTrans() const;
-    long double getPerspectiveFocal() const;
-    long double getSpinInteraction() const;
-    long double getEMFieldStrength() const;
-    long double getRenormFactor() const;
-    long double getVacuumEnergy() const;
+    Accum getGodWaveFreq() const;
+    Accum getInfluence() const;
+    Accum getWeak() const;
+    Accum getCollapse() const;
+    Accum getTwoD() const;
+    Accum getThreeDInfluence() const;
+    Accum getOneDPermeation() const;
+    Accum getNurbMatterStrength() const;
+    Accum getNurbEnergyStrength() const;
+    Accum getAlpha() const;
+    Accum getBeta() const;
+    Accum getCarrollFactor() const;
+    Accum getMeanFieldApprox() const;
+    Accum getAsymCollapse() const;
+    Accum getPerspectiveTrans() const;
+    Accum getPerspectiveFocal() const;
+    Accum getSpinInteraction() const;
+    Accum getEMFieldStrength() const;
+    Accum getRenormFactor() const;
+    Accum getVacuumEnergy() const;
+    UE::GravitySolver getGravitySolver() const;
+    Accum getOpeningAngle() const;
+    int getMeshGridSize() const;
+    UE::Integrator getIntegrator() const;
+    Accum getPotentialTargetError() const;
+    int getPotentialStrata() const;
+    int getPotentialMaxRounds() const;
+    uint64_t getPotentialSeed() const;
     bool getNeedsUpdate() const;
-    long double getTotalCharge() const;
-    long double getAvgProjScale() const;
+    Accum getTotalCharge() const;
+    Accum getAvgProjScale() const;
     float getSimulationTime() const;
-    long double getMaterialDensity() const;
+    Accum getMaterialDensity() const;
     uint64_t getCurrentVertices() const;
-    long double getOmega() const;
-    long double getInvMaxDim() const;
-    const std::vector<std::vector<long double>>& getNCubeVertices() const;
-    const std::vector<std::vector<long double>>& getVertexMomenta() const;
-    const std::vector<long double>& getVertexSpins() const;
-    const std::vector<long double>& getVertexWaveAmplitudes() const;
-    const std::vector<UE::DimensionInteraction>& getInteractions() const;
+    Accum getOmega() const;
+    Accum getInvMaxDim() const;
+    const UE::VertexStore<Real>& getNCubeVertices() const;
+    const UE::VertexStore<Real>& getVertexMomenta() const;
+    std::span<const Real> getNCubePlane(int dimension) const;
+    std::span<const Real> getMomentumPlane(int dimension) const;
+    const std::vector<Real>& getVertexSpins() const;
+    const std::vector<Real>& getVertexWaveAmplitudes() const;
+    const UE::InteractionStore<Real>& getInteractions() const;
     const std::vector<glm::vec3>& getProjectedVerts() const;
-    const std::vector<long double>& getCachedCos() const;
-    const std::vector<long double>& getNurbMatterControlPoints() const;
-    const std::vector<long double>& getNurbEnergyControlPoints() const;
-    const std::vector<long double>& getNurbKnots() const;
-    const std::vector<long double>& getNurbWeights() const;
+    const std::vector<Accum>& getCachedCos() const;
+    const std::vector<Accum>& getNurbMatterControlPoints() const;
+    const std::vector<Accum>& getNurbEnergyControlPoints() const;
+    const std::vector<Accum>& getNurbKnots() const;
+    const std::vector<Accum>& getNurbWeights() const;
     const std::vector<UE::DimensionData>& getDimensionData() const;
     DimensionalNavigator* getNavigator() const;
-    const std::vector<long double>& getNCubeVertex(int vertexIndex) const;
-    const std::vector<long double>& getVertexMomentum(int vertexIndex) const;
-    long double getVertexSpin(int vertexIndex) const;
-    long double getVertexWaveAmplitude(int vertexIndex) const;
+    typename UE::VertexStore<Real>::ConstVertexView getNCubeVertex(int vertexIndex) const;
+    typename UE::VertexStore<Real>::ConstVertexView getVertexMomentum(int vertexIndex) const;
+    Real getVertexSpin(int vertexIndex) const;
+    Real getVertexWaveAmplitude(int vertexIndex) const;
+    // Sampled potential of one vertex and its standard error from the last full compute() pass; 0 before one ran
+    Accum getVertexPotential(int vertexIndex) const;
+    Accum getVertexPotentialError(int vertexIndex) const;
     const glm::vec3& getProjectedVertex(int vertexIndex) const;
 
     // Setters
     void setCurrentDimension(int dimension);
     void setMode(int mode);
-    void setInfluence(long double value);
-    void setWeak(long double value);
-    void setCollapse(long double value);
-    void setTwoD(long double value);
-    void setThreeDInfluence(long double value);
-    void setOneDPermeation(long double value);
-    void setNurbMatterStrength(long double value);
-    void setNurbEnergyStrength(long double value);
-    void setAlpha(long double value);
-    void setBeta(long double value);
-    void setCarrollFactor(long double value);
-    void setMeanFieldApprox(long double value);
-    void setAsymCollapse(long double value);
-    void setPerspectiveTrans(long double value);
-    void setPerspectiveFocal(long double value);
-    void setSpinInteraction(long double value);
-    void setEMFieldStrength(long double value);
-    void setRenormFactor(long double value);
-    void setVacuumEnergy(long double value);
-    void setGodWaveFreq(long double value);
+    void setInfluence(Accum value);
+    void setWeak(Accum value);
+    void setCollapse(Accum value);
+    void setTwoD(Accum value);
+    void setThreeDInfluence(Accum value);
+    void setOneDPermeation(Accum value);
+    void setNurbMatterStrength(Accum value);
+    void setNurbEnergyStrength(Accum value);
+    void setAlpha(Accum value);
+    void setBeta(Accum value);
+    void setCarrollFactor(Accum value);
+    // Weight of the O(N) mean-field gravity blended into the potential and accelerations; 1 skips the pairwise terms
+    void setMeanFieldApprox(Accum value);
+    void setAsymCollapse(Accum value);
+    void setPerspectiveTrans(Accum value);
+    void setPerspectiveFocal(Accum value);
+    void setSpinInteraction(Accum value);
+    void setEMFieldStrength(Accum value);
+    void setRenormFactor(Accum value);
+    void setVacuumEnergy(Accum value);
+    void setGravitySolver(UE::GravitySolver solver);
+    void setOpeningAngle(Accum value);
+    void setMeshGridSize(int cells);
+    void setIntegrator(UE::Integrator integrator);
+    // Potential estimator: refinement stops at the target relative standard error or after the round budget
+    void setPotentialTargetError(Accum value);
+    void setPotentialStrata(int value);
+    void setPotentialMaxRounds(int value);
+    void setPotentialSeed(uint64_t seed);
+    void setGodWaveFreq(Accum value);
     void setDebug(bool value);
     void setCurrentVertices(uint64_t value);
     void setNavigator(DimensionalNavigator* nav);
-    void setNCubeVertex(int vertexIndex, const std::vector<long double>& vertex);
-    void setVertexMomentum(int vertexIndex, const std::vector<long double>& momentum);
-    void setVertexSpin(int vertexIndex, long double spin);
-    void setVertexWaveAmplitude(int vertexIndex, long double amplitude);
+    void setNCubeVertex(int vertexIndex, const std::vector<Real>& vertex);
+    void setVertexMomentum(int vertexIndex, const std::vector<Real>& momentum);
+    void setVertexSpin(int vertexIndex, Real spin);
+    void setVertexWaveAmplitude(int vertexIndex, Real amplitude);
     void setProjectedVertex(int vertexIndex, const glm::vec3& vertex);
-    void setNCubeVertices(const std::vector<std::vector<long double>>& vertices);
-    void setVertexMomenta(const std::vector<std::vector<long double>>& momenta);
-    void setVertexSpins(const std::vector<long double>& spins);
-    void setVertexWaveAmplitudes(const std::vector<long double>& amplitudes);
+    void setNCubeVertices(const std::vector<std::vector<Real>>& vertices);
+    void setVertexMomenta(const std::vector<std::vector<Real>>& momenta);
+    void setVertexSpins(const std::vector<Real>& spins);
+    void setVertexWaveAmplitudes(const std::vector<Real>& amplitudes);
     void setProjectedVertices(const std::vector<glm::vec3>& vertices);
-    void setTotalCharge(long double value);
-    void setMaterialDensity(long double density);
+    void setTotalCharge(Accum value);
+    void setMaterialDensity(Accum density);
 
     // Core Methods
     void initializeNCube();
@@ -247,83 +389,288 @@ public:
     void initializeCalculator(AMOURANTH* amouranth);
     void updateInteractions();
     UE::EnergyResult compute();
-    void evolveTimeStep(long double dt);
+    // compute() over an implicit vertex set with the current parameters, without touching this instance. Only the
+    // vertices written into its overlay are stored, so a lattice of any size costs O(1) to create.
+    UE::EnergyResult compute(const UE::ProceduralVertices<Real, Accum>& vertices) const;
+    void evolveTimeStep(Accum dt);
     void updateMomentum();
+    void computeAccelerations(UE::VertexStore<Accum>& out);
     void advanceCycle();
-    std::vector<UE::DimensionData> computeBatch(int startDim, int endDim);
+    // Runs `steps` integrator steps of size dt inside one parallel region. advanceCycle() is advance(1, 0.01).
+    void advance(int steps, Accum dt);
+    // Integrates over totalTime in steps of dt, each split into `substeps` integrator steps; a final partial
+    // step lands exactly on totalTime.
+    void advance(Accum totalTime, Accum dt, int substeps);
+    // Evaluates every dimension in [startDim, endDim] on its own implicit initial lattice, concurrently,
+    // without touching this instance. The first overload returns results sorted by dimension; the second
+    // streams each result as soon as its dimension finishes (calls are serialized, order is unspecified).
+    using DimensionDataCallback = std::function<void(const UE::DimensionData&)>;
+    std::vector<UE::DimensionData> computeBatch(int startDim, int endDim) const;
+    void computeBatch(int startDim, int endDim, const DimensionDataCallback& onResult) const;
+    // Evaluates compute() on the initial lattice at `dimension` for every parameter set (see ue_sweep.hpp for
+    // grid and Latin-hypercube builders), without touching this instance. The lattice is generated and reduced once;
+    // each set then costs O(1). Results match a fresh instance per set up to rounding.
+    UE::SweepResults sweep(std::span<const UE::Params<Accum>> points, int dimension) const;
     void exportToCSV(const std::string& filename, const std::vector<UE::DimensionData>& data) const;
+    // Writes results as CSV or an Arrow IPC stream (see ue_export.hpp). With UE::ExportMode::Append the rows are
+    // added to an existing file of the same layout, so a sweep run in pieces streams into one file.
+    void exportResults(const std::string& path, std::span<const UE::DimensionData> data,
+                       const UE::ExportOptions& options = {}) const;
+    void exportResults(const std::string& path, const UE::SweepResults& results,
+                       const UE::ExportOptions& options = {}) const;
+    // Writes parameters, simulation time and the vertex state to a checkpoint (see ue_checkpoint.hpp). The state is
+    // copied before returning, so the simulation may keep running while the file is written in the background;
+    // the future reports completion and rethrows write errors.
+    std::future<void> saveCheckpoint(const std::string& path, const UE::CheckpointOptions& options = {}) const;
+    // Starts recording advance() into a trajectory file (see ue_trajectory.hpp): the energies after every
+    // options.stepInterval-th integrator step, counted from this call, and the positions on every
+    // options.frameInterval-th recorded row. The current state is recorded as step 0. Each recorded step costs a
+    // compute(); compression and disk writes run on the writer's own thread. Replaces a running recording.
+    std::shared_ptr<UE::TrajectoryWriter> recordTrajectory(const std::string& path,
+                                                           const UE::TrajectoryOptions& options = {});
+    // Closes the recording and rethrows any error from its writer thread
+    void stopTrajectory();
+    // Restores an instance from a checkpoint of the same precision. Uncompressed position and momentum planes are
+    // mapped copy-on-write from the file rather than read; storage applies to later reallocations. verify checks
+    // the section checksums first, which reads the whole file once.
+    static std::unique_ptr<UniversalEquationT> loadCheckpoint(const std::string& path,
+                                                              const UE::VertexStorage& storage = {},
+                                                              bool verify = true);
     UE::DimensionData updateCache();
-    long double computeGodWaveAmplitude(int vertexIndex, long double time) const;
-    long double computeNurbMatter(int vertexIndex) const;
-    long double computeNurbEnergy(int vertexIndex) const;
-    long double computeSpinEnergy(int vertexIndex) const;
-    long double computeEMField(int vertexIndex) const;
-    long double computeGodWave(int vertexIndex) const;
-    long double computeInteraction(int vertexIndex, long double distance) const;
-    std::vector<long double> computeVectorPotential(int vertexIndex) const;
-    long double computeGravitationalPotential(int vertexIndex, int otherIndex) const;
-    std::vector<long double> computeGravitationalAcceleration(int vertexIndex) const;
-    long double computeKineticEnergy(int vertexIndex) const;
+    Accum computeGodWaveAmplitude(int vertexIndex, Accum time) const;
+    Accum computeNurbMatter(int vertexIndex) const;
+    Accum computeNurbEnergy(int vertexIndex) const;
+    Accum computeSpinEnergy(int vertexIndex) const;
+    Accum computeEMField(int vertexIndex) const;
+    // Coulomb field and potential of every vertex on the particle mesh, with the wave amplitudes as charges and
+    // the emFieldStrength * 0.01 scale of computeEMField
+    void computeEMFieldMesh(UE::VertexStore<Accum>& field, std::vector<Accum>& potential);
+    Accum computeGodWave(int vertexIndex) const;
+    Accum computeInteraction(int vertexIndex, Accum distance) const;
+    std::array<Real, 3> computeVectorPotential(int vertexIndex) const;
+    Accum computeGravitationalPotential(int vertexIndex, int otherIndex) const;
+    std::vector<Accum> computeGravitationalAcceleration(int vertexIndex) const;
+    Accum computeKineticEnergy(int vertexIndex) const;
 
     // Utility Methods
-    long double safeExp(long double x) const;
-    long double safe_div(long double a, long double b) const;
+    Accum safeExp(Accum x) const;
+    Accum safe_div(Accum a, Accum b) const;
     void validateVertexIndex(int vertexIndex, const std::source_location& loc = std::source_location::current()) const;
     void validateProjectedVertices() const;
 
 private:
-    std::atomic<long double> influence_;
-    std::atomic<long double> weak_;
-    std::atomic<long double> collapse_;
-    std::atomic<long double> twoD_;
-    std::atomic<long double> threeDInfluence_;
-    std::atomic<long double> oneDPermeation_;
-    std::atomic<long double> nurbMatterStrength_;
-    std::atomic<long double> nurbEnergyStrength_;
-    std::atomic<long double> alpha_;
-    std::atomic<long double> beta_;
-    std::atomic<long double> carrollFactor_;
-    std::atomic<long double> meanFieldApprox_;
-    std::atomic<long double> asymCollapse_;
-    std::atomic<long double> perspectiveTrans_;
-    std::atomic<long double> perspectiveFocal_;
-    std::atomic<long double> spinInteraction_;
-    std::atomic<long double> emFieldStrength_;
-    std::atomic<long double> renormFactor_;
-    std::atomic<long double> vacuumEnergy_;
-    std::atomic<long double> godWaveFreq_;
+    // Derived interaction fields a state change invalidates; updateInteractions() refreshes only these.
+    // Per-vertex marks use the same bits.
+    enum DirtyField : unsigned {
+        kDirtyNone = 0,
+        kDirtyStructure = 1u << 0,       // Vertex count or dimension changed, rebuild everything
+        kDirtyDistance = 1u << 1,        // Distance to the centroid, and the strength derived from it
+        kDirtyStrength = 1u << 2,        // Strength only (influence)
+        kDirtyProjection = 1u << 3,      // Perspective projection (positions, perspectiveTrans, perspectiveFocal)
+        kDirtyVectorPotential = 1u << 4, // Momenta or weak
+        kDirtyGodWave = 1u << 5,         // Wave amplitudes or godWaveFreq
+        kDirtyEnergy = 1u << 6,          // Feeds compute() only, nothing cached to refresh
+        kDirtyEnergySums = 1u << 7,      // Positions, momenta or influence: compute() needs a full vertex pass
+        kDirtyGeometry = kDirtyDistance | kDirtyProjection
+    };
+    // Fixed block count for drift's momentum sums, so the centroid update does not depend on the team size
+    static constexpr size_t kCentroidBlocks = 64;
+
+    // Selects the constructor that sets up parameters and storage but leaves the vertex state empty, for
+    // loadCheckpoint() and the public constructors to fill in
+    struct DeferInitialization {};
+    UniversalEquationT(DeferInitialization, const UE::Params<Accum>& params, int maxDimensions, int mode, bool debug,
+                       uint64_t numVertices, const UE::VertexStorage& storage);
+    // Selects the constructor behind fork(), which shares other's vertex arrays instead of re-initializing them
+    struct ForkState {};
+    UniversalEquationT(ForkState, const UniversalEquationT& other);
+    // Gives the position, momentum and acceleration planes their own buffers before a parallel region writes
+    // them (see UE::VertexStore)
+    void detachVertexState();
+
+    // Applies mutate to the pending transaction, or publishes a new snapshot right away when none is open.
+    // dirty names the derived fields that depend on the mutated parameters.
+    template<typename F>
+    void updateParams(F&& mutate, unsigned dirty);
+    void markDirty(unsigned fields);
+    void markVertexDirty(size_t vertexIndex, unsigned fields);
+    // Recomputes the per-dimension coordinate sums the centroid is derived from
+    void rebuildCentroidSum(size_t dimensions, uint64_t numVertices);
+    // numVertices, or std::invalid_argument when the storage cannot hold that many
+    static uint64_t checkedVertexCount(uint64_t numVertices, const UE::VertexStorage& storage);
+
+    // Dense copy of the UE::ProceduralVertices lattice, written by initializeNCube()
+    static void initialVertexState(UE::VertexStore<Real>& positions, UE::VertexStore<Real>& momenta);
+    static void initialScalars(std::vector<Real>& spins, std::vector<Real>& amplitudes, uint64_t count,
+                               Accum oneDPermeation);
+    static UE::DimensionData toDimensionData(int dimension, const UE::EnergyResult& result);
+
+    // One energy evaluation over a vertex set. compute() points it at the live state, computeBatch() and sweep()
+    // at implicit lattices that are never materialized. The potential is estimated in refinement rounds that each draw one partner per stratum
+    // of the vertex range; blocks within a round are independent, so any scheduler may run them.
+    static constexpr size_t kMaxEnergyStrata = 256;
+    enum EnergyTerm : size_t { kPotentialTerm, kAmplitudeTerm, kSpinTerm, kMomentumSquaredTerm, kEnergyTerms };
+    struct EnergyScratch {
+        UE::VertexStore<Accum> gathered;    // Coordinates of the current round's partners
+        std::vector<uint64_t> sampleIndex;  // Partner drawn from each stratum
+        std::vector<Accum> sampleWeight;    // Stratum sizes
+        std::vector<Accum> partials;        // kEnergyTerms x blocks block totals
+        UE::SharedVector<Accum> vertexMean; // Per-vertex running potential estimate, when tracked
+        UE::SharedVector<Accum> vertexM2;   // Per-vertex squared deviations across rounds, when tracked
+    };
+    struct EnergyPass {
+        const UE::VertexStore<Real>* positions = nullptr;
+        const UE::VertexStore<Real>* momenta = nullptr;
+        const Real* spins = nullptr;
+        const Real* amplitudes = nullptr;
+        // Implicit source, generated per vertex; the four dense pointers above are null when it is set
+        const UE::ProceduralVertices<Real, Accum>* procedural = nullptr;
+        uint64_t count = 0;
+        int dimensions = 0;
+        Accum influence = Accum(0);
+        // Weight of the mean-field potential; at 1 no partners are sampled and a single round runs
+        Accum meanFieldWeight = Accum(0);
+        const UE::MeanFieldGravity<Real, Accum>* meanField = nullptr;
+        size_t strata = 0;
+        int round = 0; // Round 0 also sums the spin, amplitude and momentum terms
+        size_t blocks = 0;
+        const uint64_t* sampleIndex = nullptr;
+        const Accum* sampleWeight = nullptr;
+        const UE::VertexStore<Accum>* gathered = nullptr;
+        Accum* partials = nullptr;
+        Accum* vertexMean = nullptr;
+        Accum* vertexM2 = nullptr;
+        void (*kernel)(const EnergyPass&, size_t) noexcept = nullptr; // energyBlockFor instance for the dimensions
+    };
+    // Totals of one energy evaluation; the potential is the mean of the round estimates
+    struct EnergySums {
+        Accum potential;
+        Accum amplitude;
+        Accum spin;
+        Accum momentumSquared;
+        Accum potentialVariance; // Variance of the potential estimate
+        int potentialRounds;
+    };
+    static EnergyPass prepareEnergyPass(const UE::VertexStore<Real>& positions, const UE::VertexStore<Real>& momenta,
+                                        const std::vector<Real>& spins, const std::vector<Real>& amplitudes,
+                                        int dimensions, Accum influence, int strata, EnergyScratch& scratch,
+                                        bool trackVertices, const UE::MeanFieldGravity<Real, Accum>* meanField,
+                                        Accum meanFieldWeight);
+    static EnergyPass prepareEnergyPass(const UE::ProceduralVertices<Real, Accum>& vertices, int dimensions,
+                                        Accum influence, int strata, EnergyScratch& scratch, bool trackVertices,
+                                        const UE::MeanFieldGravity<Real, Accum>* meanField, Accum meanFieldWeight);
+    // Sets up sampling, blocks and partials once the source fields of pass are filled in
+    static void finishEnergyPass(EnergyPass& pass, int strata, EnergyScratch& scratch, bool trackVertices);
+    static void drawEnergySamples(const EnergyPass& pass, EnergyScratch& scratch, uint64_t seed);
+    static void energyBlock(const EnergyPass& pass, size_t block) noexcept;
+    template<int Dims, bool Procedural>
+    static void energyBlockFor(const EnergyPass& pass, size_t block) noexcept;
+    // Runs refinement rounds until the target relative error or the round budget in params is reached.
+    // forBlocks(pass) must call energyBlock for every block of the pass.
+    template<typename ForBlocks>
+    static EnergySums runEnergyPass(EnergyPass& pass, EnergyScratch& scratch, const UE::Params<Accum>& params,
+                                    ForBlocks&& forBlocks);
+    UE::EnergyResult energyFromSums(const EnergySums& sums, uint64_t count, const UE::Params<Accum>& params) const;
+
+    // Active gravity dimensions for a snapshot; checks solver capacity before a parallel region is entered
+    int gravityDimensions(const UE::Params<Accum>& params) const;
+
+    // Worksharing stages shared by the single-step methods and advance(); every thread of the enclosing
+    // parallel region must reach them. The snapshot is taken before the region so the whole team follows the
+    // same path.
+    void computeAccelerationsTeam(const UE::Params<Accum>& params, int dimensions, UE::VertexStore<Accum>& out);
+    void kickTeam(Accum scale);
+    void driftTeam(Accum dt);
+    template<UE::Integrator I>
+    void stepTeam(const UE::Params<Accum>& params, int dimensions, Accum h);
+    // Runs `steps` steps of h followed by `tailSteps` steps of tailH with the selected integrator. A running
+    // trajectory splits the run at its recorded steps.
+    void integrate(std::int64_t steps, Accum h, std::int64_t tailSteps, Accum tailH);
+    // accelerationsCurrent skips the opening force evaluation of first-same-as-last schemes when accelerations_
+    // already holds it, so a split run matches an unsplit one
+    template<UE::Integrator I>
+    void integrateWith(const UE::Params<Accum>& params, int dimensions, std::int64_t steps, Accum h,
+                       std::int64_t tailSteps, Accum tailH, bool accelerationsCurrent);
+    // Appends the current energies, and positions when a frame is due, to trajectory_
+    void recordTrajectoryStep();
+    // Opens a UE::ResultWriter on path, lets write() add rows and closes it, logging the outcome
+    template<typename Write>
+    static void exportRows(const std::string& path, std::vector<UE::ExportColumn> columns,
+                           const UE::ExportOptions& options, std::size_t rows, Write&& write);
+
+    // Published parameter snapshot; replaced wholesale by setters or commit(), never modified in place
+    std::atomic<std::shared_ptr<const UE::Params<Accum>>> params_;
+    std::mutex paramsMutex_; // Serializes writers and guards the open transaction below
+    UE::Params<Accum> pendingParams_;
+    int updateDepth_;
+    unsigned pendingDirty_;
     std::atomic<int> currentDimension_;
     std::atomic<int> mode_;
     std::atomic<bool> debug_;
     std::atomic<bool> needsUpdate_;
-    std::atomic<long double> totalCharge_;
-    std::atomic<long double> avgProjScale_;
+    std::atomic<unsigned> dirty_; // DirtyField bits applying to every vertex
+    std::atomic<Accum> totalCharge_;
+    std::atomic<Accum> avgProjScale_;
     std::atomic<float> simulationTime_;
-    std::atomic<long double> materialDensity_;
     std::atomic<uint64_t> currentVertices_;
-    const uint64_t maxVertices_;
-    const int maxDimensions_;
-    const long double omega_;
-    const long double invMaxDim_;
-    std::vector<std::vector<long double>> nCubeVertices_;
-    std::vector<std::vector<long double>> vertexMomenta_;
-    std::vector<long double> vertexSpins_;
-    std::vector<long double> vertexWaveAmplitudes_;
-    std::vector<UE::DimensionInteraction> interactions_;
-    std::vector<glm::vec3> projectedVerts_;
-    std::vector<long double> cachedCos_;
-    std::vector<long double> nurbMatterControlPoints_;
-    std::vector<long double> nurbEnergyControlPoints_;
-    std::vector<long double> nurbKnots_;
-    std::vector<long double> nurbWeights_;
+    UE::VertexStorage vertexStorage_; // Backing of the coordinate, momentum, interaction and acceleration planes
+    uint64_t maxVertices_;
+    int maxDimensions_;
+    Accum omega_;
+    Accum invMaxDim_;
+    UE::VertexStore<Real> nCubeVertices_;
+    UE::VertexStore<Real> vertexMomenta_;
+    UE::SharedVector<Real> vertexSpins_;
+    UE::SharedVector<Real> vertexWaveAmplitudes_;
+    UE::InteractionStore<Real> interactions_;
+    UE::SharedVector<glm::vec3> projectedVerts_;
+    std::vector<Accum> cachedCos_;
+    std::vector<Accum> nurbMatterControlPoints_;
+    std::vector<Accum> nurbEnergyControlPoints_;
+    std::vector<Accum> nurbKnots_;
+    std::vector<Accum> nurbWeights_;
     std::vector<UE::DimensionData> dimensionData_;
     DimensionalNavigator* navigator_;
+    UE::BarnesHutTree<Real, Accum> barnesHut_;
+    UE::PairwiseGravityKernel<Real, Accum> pairwiseGravity_;
+    UE::MeanFieldGravity<Real, Accum> meanField_; // Refitted whenever meanFieldApprox > 0
+    UE::ParticleMeshSolver<Real, Accum> particleMesh_;
+    UE::VertexStore<Accum> accelerations_;
+    EnergyScratch energyScratch_;           // Sampling state and per-vertex potential statistics of compute()
+    UE::SharedVector<uint8_t> vertexDirty_; // DirtyField bits of single vertices changed through setters
+    std::vector<size_t> dirtyVertices_;     // Indices with a non-zero vertexDirty_ entry
+    std::vector<Accum> centroidSum_;        // Per-dimension coordinate sums, kept current by drift and setNCubeVertex
+    std::vector<Accum> centroid_;           // Centroid the cached distances were measured against
+    std::vector<Accum> driftPartials_;      // Per-block momentum sums folded into centroidSum_ by driftTeam
+    std::vector<Accum> reductionPartials_;  // Per-block totals of the reproducible reductions
+    EnergySums energySums_;                 // Totals behind the last compute(); spin and amplitude kept current
+    std::atomic<bool> energySumsStale_;     // Potential or momentum totals need a full vertex pass
+    std::shared_ptr<UE::TrajectoryWriter> trajectory_; // Running recording of advance(), if any; not copied
+    uint64_t trajectoryStep_;                          // Integrator steps since recordTrajectory()
 };
 
+using UniversalEquation = UniversalEquationT<long double, long double>;
+using UniversalEquationD = UniversalEquationT<double, double>;
+using UniversalEquationF = UniversalEquationT<float, float>;
+using UniversalEquationMixed = UniversalEquationT<float, double>;
+
 class AMOURANTH {
 public:
+    using Simulation = std::variant<UniversalEquation, UniversalEquationD, UniversalEquationF, UniversalEquationMixed>;
+
+    // Runs f against whichever UniversalEquationT instantiation was selected at construction
+    template<typename F>
+    decltype(auto) visitSimulation(F&& f) {
+        return std::visit(std::forward<F>(f), universalEquation_);
+    }
+
+    template<typename F>
+    decltype(auto) visitSimulation(F&& f) const {
+        return std::visit(std::forward<F>(f), universalEquation_);
+    }
+
     AMOURANTH(DimensionalNavigator* navigator, VkDevice logicalDevice, VkDeviceMemory vertexMemory,
-              VkDeviceMemory indexMemory, VkPipeline pipeline)
+              VkDeviceMemory indexMemory, VkPipeline pipeline, UE::Precision precision = UE::Precision::LongDouble)
         : navigator_(navigator),
           logicalDevice_(logicalDevice),
           vertexMemory_(vertexMemory),
@@ -333,7 +680,8 @@ public:
           currentDimension_(3),
           nurbMatter_(0.5f),
           nurbEnergy_(1.0f),
-          universalEquation_(9, 1, 1.0L, 0.1L, false, 30000),
+          precision_(precision),
+          universalEquation_(makeSimulation(precision)),
           position_(glm::vec3(0.0f, 0.0f, -5.0f)),
           target_(glm::vec3(0.0f)),
           up_(glm::vec3(0.0f, 1.0f, 0.0f)),
@@ -347,9 +695,12 @@ public:
             LOG_ERROR("AMOURANTH constructor: Null navigator provided", std::source_location::current());
             throw std::runtime_error("AMOURANTH: Null navigator provided");
         }
-        universalEquation_.setNavigator(navigator_);
-        universalEquation_.initializeCalculator(this);
-        LOG_INFO("AMOURANTH initialized with dimension=3, vertices=30000", std::source_location::current());
+        visitSimulation([this](auto& ue) {
+            ue.setNavigator(navigator_);
+            ue.initializeCalculator(this);
+        });
+        LOG_INFO("AMOURANTH initialized with dimension=3, vertices=30000, precision={}",
+                 std::source_location::current(), static_cast<int>(precision_));
     }
 
     ~AMOURANTH() {
@@ -357,14 +708,16 @@ public:
     }
 
     const std::vector<glm::vec3>& getBalls() const {
-        return universalEquation_.getProjectedVerts();
+        return visitSimulation([](const auto& ue) -> const std::vector<glm::vec3>& { return ue.getProjectedVerts(); });
     }
 
     int getMode() const { return mode_; }
     int getCurrentDimension() const { return currentDimension_; }
     float getNurbMatter() const { return nurbMatter_; }
     float getNurbEnergy() const { return nurbEnergy_; }
-    const UniversalEquation& getUniversalEquation() const { return universalEquation_; }
+    UE::Precision getPrecision() const { return precision_; }
+    DimensionalNavigator* getNavigator() const { return navigator_; }
+    const Simulation& getUniversalEquation() const { return universalEquation_; }
     bool isPaused() const { return isPaused_; }
     bool isUserCamActive() const { return isUserCamActive_; }
 
@@ -377,7 +730,7 @@ public:
     }
 
     const std::vector<UE::DimensionData>& getCache() const {
-        return universalEquation_.getDimensionData();
+        return visitSimulation([](const auto& ue) -> const std::vector<UE::DimensionData>& { return ue.getDimensionData(); });
     }
 
     Logging::Logger& getLogger() const {
@@ -387,7 +740,7 @@ public:
     void setMode(int mode, const std::source_location& loc = std::source_location::current()) {
         if (mode >= 1 && mode <= 9) {
             mode_ = mode;
-            universalEquation_.setMode(mode);
+            visitSimulation([mode](auto& ue) { ue.setMode(mode); });
             LOG_DEBUG("AMOURANTH: Set mode to {}", loc, mode);
         } else {
             LOG_WARNING("AMOURANTH: Invalid mode {}, keeping mode {}", loc, mode, mode_);
@@ -395,9 +748,10 @@ public:
     }
 
     void setCurrentDimension(int dimension, const std::source_location& loc = std::source_location::current()) {
-        if (dimension >= 1 && dimension <= universalEquation_.getMaxDimensions()) {
+        int maxDimensions = visitSimulation([](const auto& ue) { return ue.getMaxDimensions(); });
+        if (dimension >= 1 && dimension <= maxDimensions) {
             currentDimension_ = dimension;
-            universalEquation_.setCurrentDimension(dimension);
+            visitSimulation([dimension](auto& ue) { ue.setCurrentDimension(dimension); });
             LOG_DEBUG("AMOURANTH: Set dimension to {}", loc, dimension);
         } else {
             LOG_WARNING("AMOURANTH: Invalid dimension {}, keeping dimension {}", loc, dimension, currentDimension_);
@@ -406,33 +760,36 @@ public:
 
     void setNurbMatter(float matter, const std::source_location& loc = std::source_location::current()) {
         nurbMatter_ = std::max(0.0f, matter);
-        universalEquation_.setNurbMatterStrength(nurbMatter_);
+        visitSimulation([this](auto& ue) { ue.setNurbMatterStrength(nurbMatter_); });
         LOG_DEBUG("AMOURANTH: Set nurb matter to {:.3f}", loc, nurbMatter_);
     }
 
     void setNurbEnergy(float energy, const std::source_location& loc = std::source_location::current()) {
         nurbEnergy_ = std::max(0.0f, energy);
-        universalEquation_.setNurbEnergyStrength(nurbEnergy_);
+        visitSimulation([this](auto& ue) { ue.setNurbEnergyStrength(nurbEnergy_); });
         LOG_DEBUG("AMOURANTH: Set nurb energy to {:.3f}", loc, nurbEnergy_);
     }
 
     void adjustNurbMatter(float delta, const std::source_location& loc = std::source_location::current()) {
         nurbMatter_ = std::max(0.0f, nurbMatter_ + delta);
-        universalEquation_.setNurbMatterStrength(nurbMatter_);
+        visitSimulation([this](auto& ue) { ue.setNurbMatterStrength(nurbMatter_); });
         LOG_DEBUG("AMOURANTH: Adjusted nurb matter by {:.3f} to {:.3f}", loc, delta, nurbMatter_);
     }
 
     void adjustNurbEnergy(float delta, const std::source_location& loc = std::source_location::current()) {
         nurbEnergy_ = std::max(0.0f, nurbEnergy_ + delta);
-        universalEquation_.setNurbEnergyStrength(nurbEnergy_);
+        visitSimulation([this](auto& ue) { ue.setNurbEnergyStrength(nurbEnergy_); });
         LOG_DEBUG("AMOURANTH: Adjusted nurb energy by {:.3f} to {:.3f}", loc, delta, nurbEnergy_);
     }
 
     void adjustInfluence(float delta, const std::source_location& loc = std::source_location::current()) {
-        long double current = universalEquation_.getInfluence();
-        long double newInfluence = std::max(0.0L, current + static_cast<long double>(delta));
-        universalEquation_.setInfluence(newInfluence);
-        LOG_DEBUG("AMOURANTH: Adjusted influence by {:.3f} to {:.3f}", loc, delta, static_cast<float>(newInfluence));
+        float newInfluence = visitSimulation([delta](auto& ue) {
+            using Accum = typename std::decay_t<decltype(ue)>::accum_type;
+            Accum influence = std::max(Accum(0), ue.getInfluence() + static_cast<Accum>(delta));
+            ue.setInfluence(influence);
+            return static_cast<float>(influence);
+        });
+        LOG_DEBUG("AMOURANTH: Adjusted influence by {:.3f} to {:.3f}", loc, delta, newInfluence);
     }
 
     void updateZoom(bool zoomIn, const std::source_location& loc = std::source_location::current()) {
@@ -472,13 +829,27 @@ public:
 
     void update(float deltaTime, const std::source_location& loc = std::source_location::current()) {
         if (!isPaused_) {
-            universalEquation_.evolveTimeStep(deltaTime);
+            visitSimulation([deltaTime](auto& ue) { ue.evolveTimeStep(deltaTime); });
             LOG_DEBUG("AMOURANTH: Updated simulation with deltaTime {:.3f}", loc, deltaTime);
         }
         aspectRatio_ = static_cast<float>(navigator_->getWidth()) / navigator_->getHeight();
     }
 
 private:
+    static Simulation makeSimulation(UE::Precision precision) {
+        switch (precision) {
+            case UE::Precision::Double:
+                return Simulation(std::in_place_type<UniversalEquationD>, 9, 1, 1.0, 0.1, false, 30000);
+            case UE::Precision::Float:
+                return Simulation(std::in_place_type<UniversalEquationF>, 9, 1, 1.0f, 0.1f, false, 30000);
+            case UE::Precision::Mixed:
+                return Simulation(std::in_place_type<UniversalEquationMixed>, 9, 1, 1.0, 0.1, false, 30000);
+            case UE::Precision::LongDouble:
+            default:
+                return Simulation(std::in_place_type<UniversalEquation>, 9, 1, 1.0L, 0.1L, false, 30000);
+        }
+    }
+
     DimensionalNavigator* navigator_;
     VkDevice logicalDevice_;
     VkDeviceMemory vertexMemory_;
@@ -488,7 +859,8 @@ private:
     int currentDimension_;
     float nurbMatter_;
     float nurbEnergy_;
-    UniversalEquation universalEquation_;
+    UE::Precision precision_;
+    Simulation universalEquation_;
     glm::vec3 position_;
     glm::vec3 target_;
     glm::vec3 up_;
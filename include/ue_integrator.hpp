@@ -0,0 +1,51 @@
+// ue_integrator.hpp
+// AMOURANTH RTX Engine, October 2025 - Time integrators for UniversalEquation.
+// Each integrator is described at compile time by its kick-drift-kick stage weights, so the stepping loop
+// is specialized per scheme and no dispatch happens inside the vertex loops.
+// Dependencies: C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_INTEGRATOR_HPP
+#define UE_INTEGRATOR_HPP
+
+#include <array>
+
+namespace UE {
+
+// Integration scheme used by UniversalEquationT::advance
+enum class Integrator {
+    Euler,    // Kick then drift with the start-of-step acceleration (legacy advanceCycle behaviour), 1st order
+    Leapfrog, // Kick-drift-kick velocity Verlet, 2nd order, one force evaluation per step
+    Yoshida4  // Triple-jump composition of leapfrog, 4th order, three force evaluations per step
+};
+
+template<Integrator I>
+struct IntegratorTraits;
+
+template<>
+struct IntegratorTraits<Integrator::Euler> {
+    static constexpr std::array<long double, 1> weights{1.0L};
+    // Euler evaluates forces at the start of the step instead of reusing the previous step's last evaluation
+    static constexpr bool firstSameAsLast = false;
+};
+
+template<>
+struct IntegratorTraits<Integrator::Leapfrog> {
+    static constexpr std::array<long double, 1> weights{1.0L};
+    static constexpr bool firstSameAsLast = true;
+};
+
+template<>
+struct IntegratorTraits<Integrator::Yoshida4> {
+    // w1 = 1 / (2 - 2^(1/3)), w0 = 1 - 2 w1
+    static constexpr long double w1 = 1.3512071919596576340476878089715L;
+    static constexpr long double w0 = -1.7024143839193152680953756179429L;
+    static constexpr std::array<long double, 3> weights{w1, w0, w1};
+    static constexpr bool firstSameAsLast = true;
+};
+
+} // namespace UE
+
+#endif // UE_INTEGRATOR_HPP
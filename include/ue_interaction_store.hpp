@@ -0,0 +1,116 @@
+// ue_interaction_store.hpp
+// AMOURANTH RTX Engine, October 2025 - Structure-of-arrays interaction storage for UniversalEquation.
+// Per-vertex interaction terms live in fixed columns laid out by vertex index, so updates write each entry in
+// place and the buffers are only reallocated when the vertex count changes. Copies share the buffers until one
+// of them writes.
+// Dependencies: ue_vertex_store.hpp, ue_shared_vector.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_INTERACTION_STORE_HPP
+#define UE_INTERACTION_STORE_HPP
+
+#include "ue_vertex_store.hpp"
+#include "ue_shared_vector.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace UE {
+
+// Value copy of one interaction entry; only the first vectorPotentialDims components are meaningful
+template<typename Real = long double>
+struct DimensionInteraction {
+    int index;
+    Real distance;
+    Real strength;
+    std::array<Real, 3> vectorPotential;
+    Real godWaveAmplitude;
+
+    DimensionInteraction(int idx, Real dist, Real str, const std::array<Real, 3>& vecPot, Real gwAmp)
+        : index(idx), distance(dist), strength(str), vectorPotential(vecPot), godWaveAmplitude(gwAmp) {}
+};
+
+template<typename Real>
+class InteractionStore {
+public:
+    static constexpr int kVectorPotentialDims = 3;
+
+    // Resizes to count entries in vertex order; existing values are kept and new ones zeroed. A no-op when the
+    // count is unchanged.
+    void resize(std::size_t count) {
+        if (count == index_.size() && columns_.dimensions() == kColumnCount) {
+            return;
+        }
+        columns_.resize(count, kColumnCount);
+        std::vector<int> index(count);
+        std::iota(index.begin(), index.end(), 0);
+        index_ = std::move(index);
+    }
+
+    // Backing of the value columns; the index column stays on the heap
+    void setStorage(const VertexStorage& storage) {
+        if (!(columns_.storage() == storage)) {
+            columns_.setStorage(storage);
+        }
+    }
+
+    void clear() noexcept {
+        columns_.clear();
+        index_.clear();
+        vectorPotentialDims_ = 0;
+    }
+
+    std::size_t size() const noexcept { return index_.size(); }
+    bool empty() const noexcept { return index_.empty(); }
+
+    // Number of vector potential components in use, min(3, dimension); unused columns are kept at zero
+    int vectorPotentialDims() const noexcept { return vectorPotentialDims_; }
+    void setVectorPotentialDims(int dims) {
+        vectorPotentialDims_ = std::clamp(dims, 0, kVectorPotentialDims);
+        for (int k = vectorPotentialDims_; k < kVectorPotentialDims; ++k) {
+            auto column = vectorPotential(k);
+            std::fill(column.begin(), column.end(), Real(0));
+        }
+    }
+
+    std::span<const int> index() const noexcept { return index_; }
+    std::span<Real> distance() { return columns_.plane(kDistance); }
+    std::span<const Real> distance() const noexcept { return columns_.plane(kDistance); }
+    std::span<Real> strength() { return columns_.plane(kStrength); }
+    std::span<const Real> strength() const noexcept { return columns_.plane(kStrength); }
+    std::span<Real> vectorPotential(int k) { return columns_.plane(kVectorPotential + k); }
+    std::span<const Real> vectorPotential(int k) const noexcept { return columns_.plane(kVectorPotential + k); }
+    std::span<Real> godWaveAmplitude() { return columns_.plane(kGodWaveAmplitude); }
+    std::span<const Real> godWaveAmplitude() const noexcept { return columns_.plane(kGodWaveAmplitude); }
+
+    DimensionInteraction<Real> operator[](std::size_t i) const noexcept {
+        std::array<Real, 3> vecPot{};
+        for (int k = 0; k < kVectorPotentialDims; ++k) {
+            vecPot[k] = columns_.plane(kVectorPotential + k)[i];
+        }
+        return DimensionInteraction<Real>(index_[i], columns_.plane(kDistance)[i], columns_.plane(kStrength)[i],
+                                          vecPot, columns_.plane(kGodWaveAmplitude)[i]);
+    }
+
+private:
+    enum Column : int {
+        kDistance = 0,
+        kStrength = 1,
+        kVectorPotential = 2, // Three consecutive columns
+        kGodWaveAmplitude = kVectorPotential + kVectorPotentialDims,
+        kColumnCount
+    };
+
+    VertexStore<Real> columns_;
+    SharedVector<int> index_;
+    int vectorPotentialDims_ = 0;
+};
+
+} // namespace UE
+
+#endif // UE_INTERACTION_STORE_HPP
@@ -0,0 +1,63 @@
+// ue_mapped_storage.hpp
+// AMOURANTH RTX Engine, October 2025 - Out-of-core vertex storage for UniversalEquation.
+// Vertex planes either live on the heap or are memory-mapped from unlinked files, so lattices larger than RAM
+// page in and out through the kernel. Kernels stream mapped planes one resident window at a time, prefetching
+// the next window and releasing the finished one.
+// Dependencies: C++20 standard library; POSIX mmap on Linux, file mappings on Windows.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_MAPPED_STORAGE_HPP
+#define UE_MAPPED_STORAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace UE {
+
+// Where vertex planes are allocated. Stores copy the setting, so it travels with copies of a store.
+struct VertexStorage {
+    enum class Backing {
+        Heap,  // Aligned heap buffers; the vertex count is capped at kMaxHeapVertices
+        Mapped // Shared mappings of unlinked files in `directory`, up to kMaxMappedVertices
+    };
+    Backing backing = Backing::Heap;
+    std::string directory;                              // Empty: the system temporary directory
+    std::size_t residentBytes = std::size_t(256) << 20; // Per store, the window kernels keep mapped while streaming
+
+    bool mapped() const noexcept { return backing == Backing::Mapped; }
+    bool operator==(const VertexStorage&) const = default;
+};
+
+// The heap cap keeps an accidental huge count from exhausting RAM; mapped stores are limited by the int vertex
+// indices of the interaction columns
+inline constexpr std::uint64_t kMaxHeapVertices = std::uint64_t(1) << 20;
+inline constexpr std::uint64_t kMaxMappedVertices = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+
+inline std::uint64_t maxVertices(const VertexStorage& storage) noexcept {
+    return storage.mapped() ? kMaxMappedVertices : kMaxHeapVertices;
+}
+
+// Offset granularity of file mappings on every supported platform (the Windows allocation granularity)
+inline constexpr std::size_t kFileMappingAlignment = std::size_t(64) << 10;
+
+// File-backed page mappings. Mapped pages start zeroed and their file space is reserved up front, so a full
+// disk fails at allocation with std::system_error instead of faulting later.
+struct MappedPages {
+    static void* map(std::size_t bytes, const std::string& directory);
+    // Maps bytes of an existing file from offset, which must be a multiple of kFileMappingAlignment. Read-only, or
+    // copy-on-write when writable: pages load on first access and writes stay private to the mapping.
+    static void* mapFile(const std::string& path, std::size_t offset, std::size_t bytes, bool writable);
+    static void unmap(void* address, std::size_t bytes) noexcept;
+    // Hints for [address, address + bytes), widened to whole pages; no-ops where unsupported
+    static void prefetch(const void* address, std::size_t bytes) noexcept;
+    static void release(const void* address, std::size_t bytes) noexcept;
+    static std::size_t pageSize() noexcept;
+};
+
+} // namespace UE
+
+#endif // UE_MAPPED_STORAGE_HPP
@@ -0,0 +1,58 @@
+// ue_params.hpp
+// AMOURANTH RTX Engine, October 2025 - Parameter snapshot for UniversalEquation.
+// All physics and solver knobs live in one trivially copyable struct that UniversalEquationT publishes as an
+// immutable snapshot. Kernels read a snapshot once and take it by const reference, so parameters stay
+// consistent within a step and no atomics are touched in inner loops.
+// Dependencies: ue_barnes_hut.hpp, ue_integrator.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_PARAMS_HPP
+#define UE_PARAMS_HPP
+
+#include "ue_barnes_hut.hpp"
+#include "ue_integrator.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace UE {
+
+template<typename Accum = long double>
+struct Params {
+    Accum influence;
+    Accum weak;
+    Accum collapse;
+    Accum twoD;
+    Accum threeDInfluence;
+    Accum oneDPermeation;
+    Accum nurbMatterStrength;
+    Accum nurbEnergyStrength;
+    Accum alpha;
+    Accum beta;
+    Accum carrollFactor;
+    Accum meanFieldApprox;
+    Accum asymCollapse;
+    Accum perspectiveTrans;
+    Accum perspectiveFocal;
+    Accum spinInteraction;
+    Accum emFieldStrength;
+    Accum renormFactor;
+    Accum vacuumEnergy;
+    Accum godWaveFreq;
+    Accum materialDensity;
+    Accum openingAngle;
+    int meshGridSize; // Particle-mesh cells per axis
+    GravitySolver gravitySolver;
+    Integrator integrator;
+    Accum potentialTargetError; // Relative standard error at which the potential estimator stops refining
+    int potentialStrata;        // Partners drawn per vertex and round
+    int potentialMaxRounds;     // Refinement round budget, at least 2
+    std::uint64_t potentialSeed;
+};
+
+static_assert(std::is_trivially_copyable_v<Params<long double>>, "Params must stay a plain snapshot");
+
+} // namespace UE
+
+#endif // UE_PARAMS_HPP
@@ -0,0 +1,85 @@
+// ue_particle_mesh.hpp
+// AMOURANTH RTX Engine, October 2025 - Particle-mesh field solver for UniversalEquation.
+// Deposits vertices onto a 3D grid with cloud-in-cell weights over their first three coordinates, solves the
+// isolated Poisson problem by FFT convolution on a zero-padded grid (Hockney-Eastwood) and interpolates the
+// field back, for O(N + G^3 log G) per solve instead of O(N^2). Uses a bundled radix-2 FFT.
+// Dependencies: OpenMP, ue_vertex_store.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_PARTICLE_MESH_HPP
+#define UE_PARTICLE_MESH_HPP
+
+#include "ue_vertex_store.hpp"
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace UE {
+
+template<typename Real, typename Accum = Real>
+class ParticleMeshSolver {
+public:
+    static constexpr int kMeshDimensions = 3;
+    static constexpr int kMinGrid = 8;
+    // The padded transform holds (2 * kMaxGrid)^3 complex cells
+    static constexpr int kMaxGrid = 64;
+
+    // Cells per axis of the region the vertices are deposited in; rounded up to a power of two in
+    // [kMinGrid, kMaxGrid]. The transform runs on twice that so the periodic convolution is not wrapped.
+    static int roundGridSize(int cells) noexcept;
+
+    // Fills field (resized to positions.size() x dimensions) with -grad(phi) at every vertex, where
+    // phi(x) = -coupling * sum_j w_j / |x - x_j| over the first min(3, dimensions) coordinates; components past the
+    // third are zero. Weights default to 1 when empty. coupling = influence gives the gravitational acceleration
+    // of the exact kernel. potential, when given, receives phi at every vertex. Results do not depend on the
+    // thread count.
+    void solve(const VertexStore<Real>& positions, int dimensions, int gridSize, std::span<const Real> weights,
+               Accum coupling, VertexStore<Accum>& field, std::vector<Accum>* potential = nullptr);
+
+    // Worksharing variant for callers that already own a parallel region; every thread of the team must reach
+    // it. Called outside a region it runs serially.
+    void solveTeam(const VertexStore<Real>& positions, int dimensions, int gridSize, std::span<const Real> weights,
+                   Accum coupling, VertexStore<Accum>& field, std::vector<Accum>* potential = nullptr);
+
+    int gridSize() const noexcept { return grid_; }
+    Accum cellSize() const noexcept { return h_; }
+
+private:
+    using Complex = std::complex<Accum>;
+
+    std::size_t cell(std::size_t x, std::size_t y, std::size_t z) const noexcept {
+        return (x * fft_ + y) * fft_ + z;
+    }
+    // Mesh coordinate of vertex i along axis k; cells [1, grid_ - 1] hold the deposit, [0, grid_] the gradient
+    Accum meshCoordinate(const VertexStore<Real>& positions, int k, std::size_t i) const noexcept;
+    // Rebuilds twiddles, bit reversal and the transformed Green's function when the transform size changes
+    void prepareTransform(std::size_t size);
+    // In-place 3D transform of grid; sign -1 is forward, +1 inverse (unscaled). Team worksharing.
+    void transformTeam(std::vector<Complex>& grid, int sign);
+    void transformLine(Complex* line, int sign) const noexcept;
+
+    int grid_ = 0;
+    std::size_t fft_ = 0;         // Transform size per axis, 2 * grid_
+    std::size_t count_ = 0;
+    int meshDims_ = 0;
+    Accum h_ = Accum(1);
+    std::array<Accum, kMeshDimensions> lower_{};
+    std::vector<Complex> twiddles_;
+    std::vector<std::uint32_t> bitReverse_;
+    std::vector<Complex> greenHat_; // Transform of 1 / |n| in cell units
+    bool greenStale_ = false;       // Set by the team's first single section when greenHat_ must be rebuilt
+    std::vector<Complex> mesh_;     // Deposit, then potential
+    std::vector<Accum> bounds_;     // Per-block lower and upper bounds
+    std::vector<std::uint32_t> planeOf_;    // x cell of each vertex
+    std::vector<std::size_t> planeStart_;   // Counting-sort offsets per x cell
+    std::vector<std::size_t> order_;        // Vertices grouped by x cell, in index order within a cell
+};
+
+} // namespace UE
+
+#endif // UE_PARTICLE_MESH_HPP
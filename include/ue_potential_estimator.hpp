@@ -0,0 +1,59 @@
+// ue_potential_estimator.hpp
+// AMOURANTH RTX Engine, October 2025 - Sampling helpers for the potential estimator in UniversalEquation.
+// Partners are drawn by randomized stratified sampling from a counter-based generator: every draw is a pure
+// function of (seed, round, stratum), so any thread can produce it and results repeat exactly run to run.
+// Dependencies: C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_POTENTIAL_ESTIMATOR_HPP
+#define UE_POTENTIAL_ESTIMATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace UE {
+
+// SplitMix64 finalizer
+inline constexpr std::uint64_t mix64(std::uint64_t z) noexcept {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Stateless generator: the draw for (seed, stream, counter) never depends on which thread asks or in what order
+inline constexpr std::uint64_t counterRandom(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter) noexcept {
+    return mix64(mix64(seed ^ mix64(stream)) + counter);
+}
+
+// Equal-count strata over [0, count): stratum h covers [stratumBegin(h), stratumBegin(h + 1))
+inline constexpr std::uint64_t stratumBegin(std::uint64_t count, std::uint64_t strata, std::uint64_t h) noexcept {
+    return strata == 0 ? 0 : static_cast<std::uint64_t>((static_cast<long double>(count) * h) / strata);
+}
+
+// Uniform index in stratum h for the given round
+inline std::uint64_t stratifiedSample(std::uint64_t seed, std::uint64_t round, std::uint64_t count,
+                                      std::uint64_t strata, std::uint64_t h) noexcept {
+    const std::uint64_t begin = stratumBegin(count, strata, h);
+    const std::uint64_t size = stratumBegin(count, strata, h + 1) - begin;
+    if (size == 0) {
+        return begin;
+    }
+    const double u = static_cast<double>(counterRandom(seed, round, h) >> 11) * 0x1.0p-53;
+    return begin + std::min<std::uint64_t>(static_cast<std::uint64_t>(u * static_cast<double>(size)), size - 1);
+}
+
+// Welford update of a running mean and sum of squared deviations with the n-th value (n counts from 1)
+template<typename T>
+inline void welfordUpdate(T& mean, T& m2, T value, T n) noexcept {
+    const T delta = value - mean;
+    mean += delta / n;
+    m2 += delta * (value - mean);
+}
+
+} // namespace UE
+
+#endif // UE_POTENTIAL_ESTIMATOR_HPP
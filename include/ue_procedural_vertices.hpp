@@ -0,0 +1,170 @@
+// ue_procedural_vertices.hpp
+// AMOURANTH RTX Engine, October 2025 - Implicit vertex storage for UniversalEquation.
+// The initial lattice is a closed-form function of the vertex index, so it is generated on demand instead of
+// stored. Vertices that are written are copied into a sparse overlay sorted by index; memory is O(overrides).
+// Dependencies: OpenMP, ue_vertex_store.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_PROCEDURAL_VERTICES_HPP
+#define UE_PROCEDURAL_VERTICES_HPP
+
+#include "ue_vertex_store.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace UE {
+
+template<typename Real, typename Accum = Real>
+class ProceduralVertices {
+public:
+    // Initial lattice of vertex i out of count: every coordinate of a vertex is equal, spread over a 1-inch cube,
+    // with alternating momenta and spins and amplitudes rising 10% across the range
+    static Real latticeCoordinate(std::size_t i, std::size_t count) noexcept {
+        return static_cast<Real>((static_cast<Accum>(i) / count) * Accum(0.0254L));
+    }
+    static Real latticeMomentum(std::size_t i) noexcept {
+        return static_cast<Real>((static_cast<Accum>(i % 2) - Accum(0.5L)) * Accum(0.01L));
+    }
+    static Real latticeSpin(std::size_t i) noexcept {
+        return static_cast<Real>(i % 2 == 0 ? Accum(0.032774L) : -Accum(0.032774L));
+    }
+    static Real latticeAmplitude(std::size_t i, std::size_t count, Accum oneDPermeation) noexcept {
+        return static_cast<Real>(oneDPermeation * (Accum(1) + Accum(0.1L) * (i / static_cast<Accum>(count))));
+    }
+
+    // Read-only view of one vertex; holds the overlay row when the vertex has been written
+    class ConstVertex {
+    public:
+        ConstVertex(const ProceduralVertices& owner, std::size_t i, const Real* row) noexcept
+            : owner_(&owner), i_(i), row_(row) {}
+
+        Real operator[](std::size_t k) const noexcept { return coordinate(k); }
+        Real coordinate(std::size_t k) const noexcept {
+            return row_ ? row_[k] : latticeCoordinate(i_, owner_->count_);
+        }
+        Real momentum(std::size_t k) const noexcept {
+            return row_ ? row_[owner_->dims_ + k] : latticeMomentum(i_);
+        }
+        Real spin() const noexcept { return row_ ? row_[2 * owner_->dims_] : latticeSpin(i_); }
+        Real amplitude() const noexcept {
+            return row_ ? row_[2 * owner_->dims_ + 1] : latticeAmplitude(i_, owner_->count_, owner_->oneDPermeation_);
+        }
+        std::size_t size() const noexcept { return owner_->dims_; }
+
+    private:
+        const ProceduralVertices* owner_;
+        std::size_t i_;
+        const Real* row_;
+    };
+
+    ProceduralVertices() = default;
+
+    ProceduralVertices(std::size_t count, int dimensions, Accum oneDPermeation = Accum(1))
+        : count_(count), dims_(static_cast<std::size_t>(std::max(dimensions, 0))), oneDPermeation_(oneDPermeation) {
+        if (dimensions < 0) {
+            throw std::invalid_argument("ProceduralVertices: negative dimension count");
+        }
+    }
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    int dimensions() const noexcept { return static_cast<int>(dims_); }
+    Accum oneDPermeation() const noexcept { return oneDPermeation_; }
+
+    // One binary search when the overlay is non-empty, none otherwise
+    ConstVertex operator[](std::size_t i) const noexcept { return ConstVertex(*this, i, overlayRow(i)); }
+    Real coordinate(std::size_t i, int k) const noexcept { return (*this)[i].coordinate(static_cast<std::size_t>(k)); }
+    Real momentum(std::size_t i, int k) const noexcept { return (*this)[i].momentum(static_cast<std::size_t>(k)); }
+    Real spin(std::size_t i) const noexcept { return (*this)[i].spin(); }
+    Real amplitude(std::size_t i) const noexcept { return (*this)[i].amplitude(); }
+
+    // Writers move vertex i into the overlay on first use; O(overrides) per new vertex
+    void setCoordinates(std::size_t i, std::span<const Real> values) {
+        Real* row = writableRow(i);
+        std::copy_n(values.begin(), std::min(values.size(), dims_), row);
+    }
+    void setMomentum(std::size_t i, std::span<const Real> values) {
+        Real* row = writableRow(i);
+        std::copy_n(values.begin(), std::min(values.size(), dims_), row + dims_);
+    }
+    void setSpin(std::size_t i, Real value) { writableRow(i)[2 * dims_] = value; }
+    void setAmplitude(std::size_t i, Real value) { writableRow(i)[2 * dims_ + 1] = value; }
+
+    std::size_t overlaySize() const noexcept { return overlayIndex_.size(); }
+    bool isOverridden(std::size_t i) const noexcept { return overlayRow(i) != nullptr; }
+    std::span<const std::size_t> overriddenVertices() const noexcept { return overlayIndex_; }
+    void clearOverlay() noexcept {
+        overlayIndex_.clear();
+        overlayRows_.clear();
+    }
+
+    // Expands into dense storage, for callers that need whole planes
+    void materialize(VertexStore<Real>& positions, VertexStore<Real>& momenta, std::vector<Real>& spins,
+                     std::vector<Real>& amplitudes) const {
+        positions.reallocate(count_, static_cast<int>(dims_));
+        momenta.reallocate(count_, static_cast<int>(dims_));
+        spins.resize(count_);
+        amplitudes.resize(count_);
+        #pragma omp parallel for schedule(static)
+        for (std::size_t i = 0; i < count_; ++i) {
+            const ConstVertex vertex = (*this)[i];
+            for (std::size_t k = 0; k < dims_; ++k) {
+                positions.plane(static_cast<int>(k))[i] = vertex.coordinate(k);
+                momenta.plane(static_cast<int>(k))[i] = vertex.momentum(k);
+            }
+            spins[i] = vertex.spin();
+            amplitudes[i] = vertex.amplitude();
+        }
+    }
+
+private:
+    std::size_t rowSize() const noexcept { return 2 * dims_ + 2; }
+
+    const Real* overlayRow(std::size_t i) const noexcept {
+        if (overlayIndex_.empty()) {
+            return nullptr;
+        }
+        auto it = std::lower_bound(overlayIndex_.begin(), overlayIndex_.end(), i);
+        if (it == overlayIndex_.end() || *it != i) {
+            return nullptr;
+        }
+        return overlayRows_.data() + static_cast<std::size_t>(it - overlayIndex_.begin()) * rowSize();
+    }
+
+    Real* writableRow(std::size_t i) {
+        if (i >= count_) {
+            throw std::out_of_range("ProceduralVertices: vertex index out of range");
+        }
+        auto it = std::lower_bound(overlayIndex_.begin(), overlayIndex_.end(), i);
+        const std::size_t slot = static_cast<std::size_t>(it - overlayIndex_.begin());
+        if (it == overlayIndex_.end() || *it != i) {
+            const ConstVertex lattice(*this, i, nullptr);
+            std::vector<Real> row(rowSize());
+            for (std::size_t k = 0; k < dims_; ++k) {
+                row[k] = lattice.coordinate(k);
+                row[dims_ + k] = lattice.momentum(k);
+            }
+            row[2 * dims_] = lattice.spin();
+            row[2 * dims_ + 1] = lattice.amplitude();
+            overlayIndex_.insert(it, i);
+            overlayRows_.insert(overlayRows_.begin() + static_cast<std::ptrdiff_t>(slot * rowSize()), row.begin(),
+                                row.end());
+        }
+        return overlayRows_.data() + slot * rowSize();
+    }
+
+    std::size_t count_ = 0;
+    std::size_t dims_ = 0;
+    Accum oneDPermeation_ = Accum(1);
+    std::vector<std::size_t> overlayIndex_; // Written vertices, ascending
+    std::vector<Real> overlayRows_;         // Per written vertex: coordinates, momenta, spin, amplitude
+};
+
+} // namespace UE
+
+#endif // UE_PROCEDURAL_VERTICES_HPP
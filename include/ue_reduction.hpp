@@ -0,0 +1,85 @@
+// ue_reduction.hpp
+// AMOURANTH RTX Engine, October 2025 - Reproducible reductions for UniversalEquation.
+// Sums are split into fixed-size blocks accumulated with compensated summation, then folded in a fixed pairwise
+// tree, so totals are bit-identical whatever the thread count or schedule. Relies on strict IEEE arithmetic
+// (no -ffast-math).
+// Dependencies: OpenMP (optional), C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_REDUCTION_HPP
+#define UE_REDUCTION_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace UE {
+
+// Elements per reduction block; blocks are the unit of parallel work, so their boundaries never depend on the team
+inline constexpr std::size_t kReductionBlock = 1024;
+
+inline constexpr std::size_t reductionBlocks(std::size_t count) noexcept {
+    return (count + kReductionBlock - 1) / kReductionBlock;
+}
+
+// Neumaier-compensated running sum
+template<typename T>
+class CompensatedSum {
+public:
+    void add(T x) noexcept {
+        const T t = sum_ + x;
+        if (std::abs(sum_) >= std::abs(x)) {
+            compensation_ += (sum_ - t) + x;
+        } else {
+            compensation_ += (x - t) + sum_;
+        }
+        sum_ = t;
+    }
+
+    T value() const noexcept { return sum_ + compensation_; }
+
+private:
+    T sum_{};
+    T compensation_{};
+};
+
+// Sums values by recursive halving; runs of up to eight are added in order
+template<typename T>
+T pairwiseSum(std::span<const T> values) noexcept {
+    if (values.size() <= 8) {
+        T sum{};
+        for (T v : values) {
+            sum += v;
+        }
+        return sum;
+    }
+    const std::size_t half = values.size() / 2;
+    return pairwiseSum(values.first(half)) + pairwiseSum(values.subspan(half));
+}
+
+// Block-reduces values exactly like the fused kernels: a compensated sum per kReductionBlock elements, block
+// totals folded pairwise. partials is scratch, grown as needed.
+template<typename Accum, typename T>
+Accum reproducibleSum(std::span<const T> values, std::vector<Accum>& partials) {
+    const std::size_t blocks = reductionBlocks(values.size());
+    partials.resize(blocks);
+    Accum* const out = partials.data();
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        CompensatedSum<Accum> sum;
+        const std::size_t end = std::min(values.size(), (b + 1) * kReductionBlock);
+        for (std::size_t i = b * kReductionBlock; i < end; ++i) {
+            sum.add(static_cast<Accum>(values[i]));
+        }
+        out[b] = sum.value();
+    }
+    return pairwiseSum(std::span<const Accum>(out, blocks));
+}
+
+} // namespace UE
+
+#endif // UE_REDUCTION_HPP
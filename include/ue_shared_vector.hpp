@@ -0,0 +1,71 @@
+// ue_shared_vector.hpp
+// AMOURANTH RTX Engine, October 2025 - Copy-on-write arrays for UniversalEquation.
+// A std::vector behind a reference count: copies share the elements until one of them writes, so forking an
+// instance costs O(1) per array. Reads go through the const interface; writes ask for the vector through
+// mutate(), which copies it first when it is shared.
+// Dependencies: C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_SHARED_VECTOR_HPP
+#define UE_SHARED_VECTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace UE {
+
+template<typename T>
+class SharedVector {
+public:
+    SharedVector() = default;
+    SharedVector(std::vector<T> values) : data_(std::make_shared<std::vector<T>>(std::move(values))) {}
+
+    SharedVector& operator=(std::vector<T> values) {
+        data_ = std::make_shared<std::vector<T>>(std::move(values));
+        return *this;
+    }
+
+    std::size_t size() const noexcept { return data_ ? data_->size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    const T* data() const noexcept { return data_ ? data_->data() : nullptr; }
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + size(); }
+    const T& operator[](std::size_t i) const noexcept { return (*data_)[i]; }
+
+    const std::vector<T>& vector() const noexcept {
+        static const std::vector<T> empty;
+        return data_ ? *data_ : empty;
+    }
+
+    // The elements for writing, copied first when another SharedVector shares them. Writers running in parallel
+    // take the vector (or its data()) once, before the parallel region.
+    std::vector<T>& mutate() {
+        if (!data_) {
+            data_ = std::make_shared<std::vector<T>>();
+        } else if (data_.use_count() > 1) {
+            data_ = std::make_shared<std::vector<T>>(*data_);
+        }
+        return *data_;
+    }
+
+    // Resizing to the current size is a no-op and keeps the elements shared
+    void resize(std::size_t count, const T& value = T()) {
+        if (count != size()) {
+            mutate().resize(count, value);
+        }
+    }
+
+    void clear() noexcept { data_.reset(); }
+    bool shared() const noexcept { return data_.use_count() > 1; }
+
+private:
+    std::shared_ptr<std::vector<T>> data_;
+};
+
+} // namespace UE
+
+#endif // UE_SHARED_VECTOR_HPP
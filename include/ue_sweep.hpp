@@ -0,0 +1,107 @@
+// ue_sweep.hpp
+// AMOURANTH RTX Engine, October 2025 - Parameter sweeps for UniversalEquation.
+// Builds grid, Latin-hypercube or explicit lists of UE::Params and holds sweep results as columns, one row per
+// parameter set. Evaluation lives in UniversalEquationT::sweep, which shares one initial lattice across all sets.
+// Dependencies: ue_params.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_SWEEP_HPP
+#define UE_SWEEP_HPP
+
+#include "ue_params.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace UE {
+
+// One swept parameter: a Params field and the closed range it spans
+template<typename Accum = long double>
+struct SweepAxis {
+    Accum Params<Accum>::* field;
+    Accum low;
+    Accum high;
+    int steps = 1; // Grid points along the axis; ignored by Latin-hypercube designs
+};
+
+// Cartesian product of the axes around base; the first axis varies fastest
+template<typename Accum>
+std::vector<Params<Accum>> makeGrid(const Params<Accum>& base, std::span<const SweepAxis<Accum>> axes) {
+    std::size_t total = 1;
+    for (const auto& axis : axes) {
+        if (axis.steps < 1) {
+            throw std::invalid_argument("makeGrid: every axis needs at least one step");
+        }
+        total *= static_cast<std::size_t>(axis.steps);
+    }
+    std::vector<Params<Accum>> points(total, base);
+    for (std::size_t n = 0; n < total; ++n) {
+        std::size_t rest = n;
+        for (const auto& axis : axes) {
+            const std::size_t k = rest % static_cast<std::size_t>(axis.steps);
+            rest /= static_cast<std::size_t>(axis.steps);
+            const Accum t = axis.steps > 1 ? static_cast<Accum>(k) / static_cast<Accum>(axis.steps - 1) : Accum(0);
+            points[n].*axis.field = axis.low + t * (axis.high - axis.low);
+        }
+    }
+    return points;
+}
+
+// Latin-hypercube design: every axis range is cut into `samples` strata and each stratum is used exactly once
+template<typename Accum>
+std::vector<Params<Accum>> makeLatinHypercube(const Params<Accum>& base, std::span<const SweepAxis<Accum>> axes,
+                                              std::size_t samples, std::uint64_t seed) {
+    std::vector<Params<Accum>> points(samples, base);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+    std::vector<std::size_t> strata(samples);
+    for (const auto& axis : axes) {
+        std::iota(strata.begin(), strata.end(), std::size_t(0));
+        std::shuffle(strata.begin(), strata.end(), rng);
+        for (std::size_t n = 0; n < samples; ++n) {
+            const Accum t = (static_cast<Accum>(strata[n]) + static_cast<Accum>(jitter(rng))) / static_cast<Accum>(samples);
+            points[n].*axis.field = axis.low + t * (axis.high - axis.low);
+        }
+    }
+    return points;
+}
+
+// Columnar sweep output; row n holds the result for parameter set n
+struct SweepResults {
+    std::vector<int> dimension;
+    std::vector<long double> observable;
+    std::vector<long double> potential;
+    std::vector<long double> nurbMatter;
+    std::vector<long double> nurbEnergy;
+    std::vector<long double> spinEnergy;
+    std::vector<long double> momentumEnergy;
+    std::vector<long double> fieldEnergy;
+    std::vector<long double> GodWaveEnergy;
+    std::vector<long double> potentialError;
+
+    std::size_t size() const noexcept { return observable.size(); }
+
+    void resize(std::size_t rows) {
+        dimension.resize(rows);
+        observable.resize(rows);
+        potential.resize(rows);
+        nurbMatter.resize(rows);
+        nurbEnergy.resize(rows);
+        spinEnergy.resize(rows);
+        momentumEnergy.resize(rows);
+        fieldEnergy.resize(rows);
+        GodWaveEnergy.resize(rows);
+        potentialError.resize(rows);
+    }
+};
+
+} // namespace UE
+
+#endif // UE_SWEEP_HPP
@@ -0,0 +1,207 @@
+// ue_trajectory.hpp
+// AMOURANTH RTX Engine, October 2025 - Streaming trajectory files for UniversalEquation.
+// Per-step energies, plus vertex positions on a decimated subset of the steps, are appended in fixed-schema
+// columnar chunks. The simulation thread fills a chunk in memory and hands it to a writer thread through a
+// lock-free queue, so it never waits on disk. Chunks are compressed and checksummed, and an index at the end of
+// the file gives random access by step; a file whose writer died is still readable by scanning its chunks.
+// Dependencies: ue_checkpoint.hpp, ue_mapped_storage.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_TRAJECTORY_HPP
+#define UE_TRAJECTORY_HPP
+
+#include "ue_checkpoint.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace UE {
+
+// One recorded step: the EnergyResult fields, narrowed to double for a portable file
+struct TrajectoryRow {
+    std::uint64_t step = 0;
+    double time = 0.0;
+    double observable = 0.0;
+    double potential = 0.0;
+    double nurbMatter = 0.0;
+    double nurbEnergy = 0.0;
+    double spinEnergy = 0.0;
+    double momentumEnergy = 0.0;
+    double fieldEnergy = 0.0;
+    double godWaveEnergy = 0.0;
+    double potentialError = 0.0;
+    std::int32_t potentialRounds = 0;
+};
+
+// The double columns of a chunk, in file order
+inline constexpr std::array<double TrajectoryRow::*, 10> kTrajectoryColumns = {
+    &TrajectoryRow::time, &TrajectoryRow::observable, &TrajectoryRow::potential, &TrajectoryRow::nurbMatter,
+    &TrajectoryRow::nurbEnergy, &TrajectoryRow::spinEnergy, &TrajectoryRow::momentumEnergy,
+    &TrajectoryRow::fieldEnergy, &TrajectoryRow::godWaveEnergy, &TrajectoryRow::potentialError};
+
+struct TrajectoryOptions {
+    CheckpointCompression compression = CheckpointCompression::None;
+    int level = 3;                    // Zstd compression level; LZ4 ignores it
+    std::uint32_t stepInterval = 1;   // Record every stepInterval-th integrator step
+    std::uint32_t frameInterval = 0;  // Store positions with every frameInterval-th recorded row; 0 never
+    std::uint32_t rowsPerChunk = 4096;
+};
+
+inline constexpr std::uint64_t kTrajectoryMagic = 0x31304a4152544555ULL; // "UETRAJ01" in file byte order
+inline constexpr std::uint64_t kTrajectoryChunkMagic = 0x4b4e484352544555ULL; // "UETRCHNK"
+inline constexpr std::uint64_t kTrajectoryIndexMagic = 0x5844494a52544555ULL; // "UETRJIDX"
+inline constexpr std::uint32_t kTrajectoryVersion = 1;
+
+struct TrajectoryHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t compression; // CheckpointCompression
+    std::uint32_t realBytes;   // sizeof(Real) of the position frames
+    std::int32_t dimensions;
+    std::uint64_t vertexCount;
+    std::uint64_t planeStride; // Elements between planes of a frame, as in VertexStore
+    std::uint32_t stepInterval;
+    std::uint32_t frameInterval;
+    std::uint64_t headerChecksum; // Of every byte above
+};
+
+// Precedes every chunk. The payload holds, in order: steps (u64), each kTrajectoryColumns column (f64),
+// potentialRounds (i32, padded to 8 bytes), frame steps (u64) and the frames' position planes.
+struct TrajectoryChunkHeader {
+    std::uint64_t magic;
+    std::uint64_t firstStep;
+    std::uint64_t lastStep;
+    std::uint32_t rows;
+    std::uint32_t frames;
+    std::uint64_t storedBytes;
+    std::uint64_t rawBytes;
+    std::uint64_t checksum; // Of the stored payload
+};
+
+// Index entries follow the last chunk, then a trailer pointing back at them
+struct TrajectoryIndexEntry {
+    std::uint64_t firstStep;
+    std::uint64_t lastStep;
+    std::uint64_t offset; // Of the chunk header
+};
+
+struct TrajectoryTrailer {
+    std::uint64_t indexOffset;
+    std::uint64_t chunkCount;
+    std::uint64_t magic;
+};
+
+// Appends rows from one producer thread; a background thread compresses and writes full chunks. append() only
+// copies into memory and never blocks: chunk buffers are recycled through lock-free stacks, and a writer that
+// falls behind makes the queue grow instead of stalling the caller. Errors on the writer thread are rethrown by
+// the next append() or by close().
+class TrajectoryWriter {
+public:
+    TrajectoryWriter(const std::string& path, std::uint64_t vertexCount, int dimensions, std::size_t planeStride,
+                     std::uint32_t realBytes, const TrajectoryOptions& options = {});
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    // Whether the next append() stores a frame; callers skip gathering positions otherwise
+    bool frameDue() const noexcept;
+    // frame must hold dimensions planes of planeStride elements when frameDue(), and is ignored otherwise
+    void append(const TrajectoryRow& row, std::span<const std::byte> frame = {});
+    // Hands over the partial chunk, waits for the writer thread and writes the index. Idempotent.
+    void close();
+
+    const std::string& path() const noexcept { return path_; }
+    const TrajectoryOptions& options() const noexcept { return options_; }
+    std::uint64_t vertexCount() const noexcept { return header_.vertexCount; }
+    int dimensions() const noexcept { return header_.dimensions; }
+    std::size_t frameBytes() const noexcept { return frameBytes_; }
+    std::uint64_t rowsAppended() const noexcept { return rowsAppended_; }
+
+private:
+    struct Chunk {
+        std::vector<TrajectoryRow> rows;
+        std::vector<std::uint64_t> frameSteps;
+        std::vector<std::byte> frames;
+        Chunk* next = nullptr;
+    };
+
+    Chunk* takeChunk();
+    void submit(Chunk* chunk);
+    void writerLoop();
+    void writeChunk(const Chunk& chunk, std::vector<std::byte>& payload);
+    void rethrowWriterError();
+
+    std::string path_;
+    TrajectoryOptions options_;
+    TrajectoryHeader header_;
+    std::size_t frameBytes_;
+    std::uint64_t rowsAppended_ = 0;
+    Chunk* current_ = nullptr;                // Producer-owned chunk being filled
+    Chunk* spare_ = nullptr;                  // Producer-owned recycled chunks
+    std::atomic<Chunk*> submitted_{nullptr};  // Full chunks, newest first
+    std::atomic<Chunk*> recycled_{nullptr};   // Written chunks returned to the producer
+    std::atomic<std::uint64_t> submissions_{0};
+    std::atomic<bool> closing_{false};
+    std::atomic<bool> failed_{false};
+    bool closed_ = false;
+    std::exception_ptr error_;                // Set by the writer thread before failed_
+    std::ofstream file_;
+    std::vector<TrajectoryIndexEntry> index_; // Writer thread only
+    std::thread thread_;
+};
+
+// Random access to a trajectory file by step. Chunks are decoded on demand; the most recent one is cached, so
+// reading steps in order decodes each chunk once. Not thread-safe.
+class TrajectoryReader {
+public:
+    struct DecodedChunk {
+        std::vector<TrajectoryRow> rows;
+        std::vector<std::uint64_t> frameSteps;
+        std::vector<std::byte> frames; // frameSteps.size() frames of frameBytes() each
+    };
+
+    explicit TrajectoryReader(const std::string& path);
+    ~TrajectoryReader();
+    TrajectoryReader(const TrajectoryReader&) = delete;
+    TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+    const TrajectoryHeader& header() const noexcept { return header_; }
+    // False when the file has no index and its chunks were found by scanning
+    bool indexed() const noexcept { return indexed_; }
+    std::size_t chunkCount() const noexcept { return index_.size(); }
+    std::span<const TrajectoryIndexEntry> index() const noexcept { return index_; }
+    std::size_t frameBytes() const noexcept;
+
+    const DecodedChunk& chunk(std::size_t i) const;
+    // The row recorded at step, if any
+    std::optional<TrajectoryRow> row(std::uint64_t step) const;
+    // Copies the positions recorded at step into out (frameBytes() bytes); false when step has no frame
+    bool frame(std::uint64_t step, std::span<std::byte> out) const;
+
+private:
+    // Chunk whose step range contains step, or chunkCount()
+    std::size_t findChunk(std::uint64_t step) const noexcept;
+
+    std::string path_;
+    const std::byte* data_ = nullptr;
+    std::size_t bytes_ = 0;
+    TrajectoryHeader header_{};
+    bool indexed_ = false;
+    std::vector<TrajectoryIndexEntry> index_;
+    mutable std::size_t cachedChunk_ = static_cast<std::size_t>(-1);
+    mutable DecodedChunk cache_;
+};
+
+} // namespace UE
+
+#endif // UE_TRAJECTORY_HPP
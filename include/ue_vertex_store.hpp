@@ -0,0 +1,358 @@
+// ue_vertex_store.hpp
+// AMOURANTH RTX Engine, October 2025 - Structure-of-arrays vertex storage for UniversalEquation.
+// One contiguous, 64-byte-aligned buffer holds one coordinate plane per dimension, indexed by vertex.
+// Planes are exposed as std::span for vectorizable kernels; per-vertex views keep the [i][j] access pattern.
+// The buffer is heap-allocated or memory-mapped from a file, per the store's UE::VertexStorage. Copies share it
+// until one of them writes: the non-const accessors give the store its own copy first.
+// Dependencies: ue_mapped_storage.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#pragma once
+#ifndef UE_VERTEX_STORE_HPP
+#define UE_VERTEX_STORE_HPP
+
+#include "ue_mapped_storage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace UE {
+
+// Copy-on-write: copying is O(1), and the first non-const access to a shared buffer copies it. That access must not
+// race with other uses of the store, so writers running in parallel call detach() before the parallel region.
+template<typename T>
+class VertexStore {
+    static_assert(std::is_arithmetic_v<T>, "VertexStore holds arithmetic coordinates only");
+
+public:
+    static constexpr std::size_t kAlignment = 64;
+    // Plane stride is padded to a whole number of cache lines so every plane starts aligned
+    static constexpr std::size_t kLaneWidth = kAlignment / sizeof(T) > 0 ? kAlignment / sizeof(T) : 1;
+
+    // Strided view of one vertex across all coordinate planes
+    template<typename U>
+    class BasicVertexView {
+    public:
+        BasicVertexView(U* base, std::size_t stride, std::size_t dims) noexcept
+            : base_(base), stride_(stride), dims_(dims) {}
+
+        U& operator[](std::size_t j) const noexcept { return base_[j * stride_]; }
+        std::size_t size() const noexcept { return dims_; }
+        bool empty() const noexcept { return dims_ == 0; }
+
+        std::vector<std::remove_const_t<U>> toVector() const {
+            std::vector<std::remove_const_t<U>> out(dims_);
+            for (std::size_t j = 0; j < dims_; ++j) {
+                out[j] = base_[j * stride_];
+            }
+            return out;
+        }
+
+    private:
+        U* base_;
+        std::size_t stride_;
+        std::size_t dims_;
+    };
+
+    using VertexView = BasicVertexView<T>;
+    using ConstVertexView = BasicVertexView<const T>;
+
+    VertexStore() = default;
+
+    VertexStore(std::size_t count, int dimensions) {
+        resize(count, dimensions);
+    }
+
+    VertexStore(std::size_t count, int dimensions, const VertexStorage& storage) : storage_(storage) {
+        resize(count, dimensions);
+    }
+
+    VertexStore(const VertexStore& other)
+        : storage_(other.storage_),
+          data_(other.data_),
+          size_(other.size_),
+          stride_(other.stride_),
+          dims_(other.dims_) {}
+
+    VertexStore(VertexStore&& other) noexcept
+        : storage_(std::move(other.storage_)),
+          data_(std::move(other.data_)),
+          size_(std::exchange(other.size_, 0)),
+          stride_(std::exchange(other.stride_, 0)),
+          dims_(std::exchange(other.dims_, 0)) {}
+
+    VertexStore& operator=(const VertexStore& other) {
+        if (this != &other) {
+            VertexStore copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    VertexStore& operator=(VertexStore&& other) noexcept {
+        VertexStore moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(VertexStore& other) noexcept {
+        std::swap(storage_, other.storage_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(stride_, other.stride_);
+        std::swap(dims_, other.dims_);
+    }
+
+    // Builds a store from the legacy nested layout; every row must have exactly `dimensions` entries
+    static VertexStore fromNested(const std::vector<std::vector<T>>& rows, int dimensions,
+                                  const VertexStorage& storage = {}) {
+        VertexStore store(rows.size(), dimensions, storage);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i].size() != static_cast<std::size_t>(dimensions)) {
+                throw std::invalid_argument("VertexStore: row dimension mismatch");
+            }
+            store.setVertex(i, rows[i]);
+        }
+        return store;
+    }
+
+    // Reallocates to count x dimensions, preserving the overlapping region and zero-filling the rest
+    void resize(std::size_t count, int dimensions) {
+        if (dimensions < 0) {
+            throw std::invalid_argument("VertexStore: negative dimension count");
+        }
+        std::size_t dims = static_cast<std::size_t>(dimensions);
+        std::size_t stride = paddedStride(count);
+        if (count == size_ && dimensions == dims_) {
+            return;
+        }
+        auto fresh = allocate(stride * dims);
+        if (!storage_.mapped()) {
+            std::fill_n(fresh.get(), stride * dims, T{}); // Mapped pages start zeroed
+        }
+        std::size_t keepDims = std::min(dims, static_cast<std::size_t>(dims_));
+        std::size_t keepCount = std::min(count, size_);
+        for (std::size_t j = 0; j < keepDims; ++j) {
+            std::copy_n(data_.get() + j * stride_, keepCount, fresh.get() + j * stride);
+        }
+        data_ = std::move(fresh);
+        size_ = count;
+        stride_ = stride;
+        dims_ = dimensions;
+    }
+
+    // Reallocates to count x dimensions without preserving or zeroing the planes, for callers that write every
+    // element themselves: the first write to each page then decides where it is placed. Only the padding past
+    // size() is zeroed. A no-op when the shape is unchanged and the buffer is not shared.
+    void reallocate(std::size_t count, int dimensions) {
+        if (dimensions < 0) {
+            throw std::invalid_argument("VertexStore: negative dimension count");
+        }
+        if (count == size_ && dimensions == dims_ && !shared()) {
+            return;
+        }
+        std::size_t stride = paddedStride(count);
+        data_.reset(); // A shared buffer is left to its other owners rather than copied
+        data_ = allocate(stride * static_cast<std::size_t>(dimensions));
+        size_ = count;
+        stride_ = stride;
+        dims_ = dimensions;
+        for (int j = 0; j < dims_; ++j) {
+            std::fill(data_.get() + static_cast<std::size_t>(j) * stride_ + size_,
+                      data_.get() + static_cast<std::size_t>(j + 1) * stride_, T{});
+        }
+    }
+
+    // Maps count x dimensions planes laid out as in a store of this type (plane stride included) from offset of
+    // path, copy-on-write: pages load on first access and writes never reach the file. Later reallocations use
+    // storage.
+    static VertexStore fromFile(const std::string& path, std::size_t offset, std::size_t count, int dimensions,
+                                const VertexStorage& storage = {}) {
+        if (dimensions < 0) {
+            throw std::invalid_argument("VertexStore: negative dimension count");
+        }
+        VertexStore store;
+        store.storage_ = storage;
+        const std::size_t stride = paddedStride(count);
+        const std::size_t bytes = stride * static_cast<std::size_t>(dimensions) * sizeof(T);
+        if (bytes > 0) {
+            store.data_ = Buffer(static_cast<T*>(MappedPages::mapFile(path, offset, bytes, true)),
+                                 BufferDelete{bytes, true});
+        }
+        store.size_ = count;
+        store.stride_ = stride;
+        store.dims_ = dimensions;
+        return store;
+    }
+
+    // Moves the planes to the given backing; later allocations use it too
+    void setStorage(const VertexStorage& storage) {
+        VertexStore moved(size_, dims_, storage);
+        for (int j = 0; j < dims_; ++j) {
+            std::copy_n(std::as_const(*this).plane(j).data(), size_, moved.plane(j).data());
+        }
+        swap(moved);
+    }
+
+    const VertexStorage& storage() const noexcept { return storage_; }
+
+    // Whether a copy still shares the buffer
+    bool shared() const noexcept { return data_.use_count() > 1; }
+
+    // Gives this store its own copy of a shared buffer, on its storage; a no-op otherwise
+    void detach() {
+        if (!shared()) {
+            return;
+        }
+        const std::size_t elements = stride_ * static_cast<std::size_t>(dims_);
+        Buffer own = allocate(elements);
+        std::copy_n(data_.get(), elements, own.get());
+        data_ = std::move(own);
+    }
+
+    // Vertices per resident window: as many as fit in storage().residentBytes across all planes, and unlimited
+    // for heap stores
+    std::size_t residentVertices() const noexcept {
+        if (!storage_.mapped()) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        const std::size_t bytesPerVertex = std::max<std::size_t>(1, static_cast<std::size_t>(dims_)) * sizeof(T);
+        return std::max<std::size_t>(kLaneWidth, storage_.residentBytes / bytesPerVertex);
+    }
+
+    // Paging hints for vertices [begin, end) across all planes; no-ops for heap stores
+    void prefetch(std::size_t begin, std::size_t end) const noexcept {
+        advise(begin, end, &MappedPages::prefetch);
+    }
+    void release(std::size_t begin, std::size_t end) const noexcept {
+        advise(begin, end, &MappedPages::release);
+    }
+
+    void clear() noexcept {
+        data_.reset();
+        size_ = 0;
+        stride_ = 0;
+        dims_ = 0;
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    int dimensions() const noexcept { return dims_; }
+    std::size_t stride() const noexcept { return stride_; }
+    // Stride of a store holding count vertices
+    static std::size_t paddedStride(std::size_t count) noexcept {
+        return (count + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+    }
+
+    // Every plane back to back, stride padding included, as laid out in memory
+    std::span<T> planes() {
+        detach();
+        return {data_.get(), stride_ * static_cast<std::size_t>(dims_)};
+    }
+    std::span<const T> planes() const noexcept { return {data_.get(), stride_ * static_cast<std::size_t>(dims_)}; }
+
+    std::span<T> plane(int dimension) {
+        detach();
+        return {data_.get() + static_cast<std::size_t>(dimension) * stride_, size_};
+    }
+
+    std::span<const T> plane(int dimension) const noexcept {
+        return {data_.get() + static_cast<std::size_t>(dimension) * stride_, size_};
+    }
+
+    VertexView operator[](std::size_t i) {
+        detach();
+        return VertexView(data_.get() + i, stride_, static_cast<std::size_t>(dims_));
+    }
+
+    ConstVertexView operator[](std::size_t i) const noexcept {
+        return ConstVertexView(data_.get() + i, stride_, static_cast<std::size_t>(dims_));
+    }
+
+    void setVertex(std::size_t i, std::span<const T> values) {
+        detach();
+        std::size_t dims = std::min(values.size(), static_cast<std::size_t>(dims_));
+        for (std::size_t j = 0; j < dims; ++j) {
+            data_[j * stride_ + i] = values[j];
+        }
+    }
+
+private:
+    // Frees heap buffers, or unmaps mapped ones of mappedBytes bytes
+    struct BufferDelete {
+        std::size_t mappedBytes = 0;
+        bool privateMapping = false; // Copy-on-write file view; releasing its pages would discard writes
+        void operator()(T* ptr) const noexcept {
+            if (mappedBytes > 0) {
+                MappedPages::unmap(ptr, mappedBytes);
+            } else {
+                ::operator delete(ptr, std::align_val_t{kAlignment});
+            }
+        }
+    };
+    using Buffer = std::shared_ptr<T[]>;
+
+    Buffer allocate(std::size_t elements) const {
+        if (elements == 0) {
+            return Buffer();
+        }
+        if (storage_.mapped()) {
+            // Mappings are page-aligned, which covers kAlignment
+            const std::size_t bytes = elements * sizeof(T);
+            return Buffer(static_cast<T*>(MappedPages::map(bytes, storage_.directory)), BufferDelete{bytes});
+        }
+        return Buffer(static_cast<T*>(::operator new(elements * sizeof(T), std::align_val_t{kAlignment})),
+                      BufferDelete{});
+    }
+
+    void advise(std::size_t begin, std::size_t end, void (*hint)(const void*, std::size_t) noexcept) const noexcept {
+        end = std::min(end, size_);
+        const BufferDelete* buffer = std::get_deleter<BufferDelete>(data_);
+        if (!buffer || buffer->mappedBytes == 0 || begin >= end ||
+            (buffer->privateMapping && hint == &MappedPages::release)) {
+            return;
+        }
+        for (int j = 0; j < dims_; ++j) {
+            hint(data_.get() + static_cast<std::size_t>(j) * stride_ + begin, (end - begin) * sizeof(T));
+        }
+    }
+
+    VertexStorage storage_;
+    Buffer data_;
+    std::size_t size_ = 0;
+    std::size_t stride_ = 0;
+    int dims_ = 0;
+};
+
+// Runs f(begin, end) over [0, count) one resident window of the given stores at a time, in windows that are a
+// multiple of granularity: the next window is prefetched before f runs and the finished one released after.
+// With only heap stores f runs once over the whole range.
+template<typename F, typename... Stores>
+void streamResident(std::size_t count, std::size_t granularity, F&& f, const Stores&... stores) {
+    const std::size_t resident = std::min({stores.residentVertices()...});
+    if (resident >= count) {
+        f(std::size_t(0), count);
+        return;
+    }
+    const std::size_t window = std::max(granularity, resident / granularity * granularity);
+    (stores.prefetch(0, window), ...);
+    for (std::size_t begin = 0; begin < count; begin += window) {
+        const std::size_t end = std::min(count, begin + window);
+        (stores.prefetch(end, end + window), ...);
+        f(begin, end);
+        (stores.release(begin, end), ...);
+    }
+}
+
+} // namespace UE
+
+#endif // UE_VERTEX_STORE_HPP
@@ -161,8 +161,8 @@ void Application::handleResize(int width, int height) {
     navigator_->setHeight(height);
     LOG_DEBUG_CAT("Application", "Navigator dimensions updated", std::source_location::current());
     if (amouranth_.has_value()) {
-        amouranth_.value().getUniversalEquation().getNavigator()->setWidth(width);
-        amouranth_.value().getUniversalEquation().getNavigator()->setHeight(height);
+        amouranth_.value().getNavigator()->setWidth(width);
+        amouranth_.value().getNavigator()->setHeight(height);
         LOG_DEBUG_CAT("Application", "AMOURANTH dimensions updated", std::source_location::current());
     }
     LOG_INFO_CAT("Application", "Application resized to width: {}, height: {}", std::source_location::current(), width, height);
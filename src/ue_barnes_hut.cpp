@@ -0,0 +1,248 @@
+// ue_barnes_hut.cpp
+// AMOURANTH RTX Engine, October 2025 - Barnes-Hut gravity solver for UniversalEquation.
+// Parallel k-d tree build (OpenMP tasks over preassigned node slots) and parallel per-vertex traversal,
+// usable either standalone or as worksharing inside a caller-owned parallel region.
+// Dependencies: OpenMP, ue_barnes_hut.hpp, ue_dimension_dispatch.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_barnes_hut.hpp"
+#include "ue_dimension_dispatch.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <omp.h>
+
+namespace UE {
+
+template<typename Real, typename Accum>
+std::size_t BarnesHutTree<Real, Accum>::countNodes(std::size_t count) {
+    if (count <= kLeafSize) {
+        return 1;
+    }
+    std::size_t left = count / 2;
+    return 1 + countNodes(left) + countNodes(count - left);
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::checkCapacity(std::size_t count) {
+    if (count > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("BarnesHutTree: vertex count exceeds 32-bit index range");
+    }
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::build(const VertexStore<Real>& positions, int dimensions) {
+    checkCapacity(positions.size());
+    #pragma omp parallel
+    buildTeam(positions, dimensions);
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::buildTeam(const VertexStore<Real>& positions, int dimensions) {
+    const std::size_t count = positions.size();
+    #pragma omp single
+    {
+        dims_ = std::clamp(std::min(dimensions, positions.dimensions()), 0, kMaxDimensions);
+        nodes_.clear();
+        order_.resize(count);
+        std::iota(order_.begin(), order_.end(), 0U);
+        if (count == 0 || dims_ == 0) {
+            centers_.clear();
+            lower_.clear();
+            upper_.clear();
+            sorted_.clear();
+        } else {
+            std::size_t totalNodes = countNodes(count);
+            nodes_.resize(totalNodes);
+            centers_.assign(totalNodes * static_cast<std::size_t>(dims_), Accum(0));
+            lower_.assign(totalNodes * static_cast<std::size_t>(dims_), Accum(0));
+            upper_.assign(totalNodes * static_cast<std::size_t>(dims_), Accum(0));
+            sorted_.resize(count * static_cast<std::size_t>(dims_));
+            // Subtree tasks are picked up by the rest of the team waiting at the closing barrier
+            buildNode(positions, 0, 0, count);
+        }
+    }
+    if (nodes_.empty()) {
+        return;
+    }
+
+    // Copy coordinates into tree order so leaf sums and traversal walk contiguous memory
+    for (int j = 0; j < dims_; ++j) {
+        auto coords = positions.plane(j);
+        Accum* dst = sorted_.data() + static_cast<std::size_t>(j) * count;
+        #pragma omp for schedule(static)
+        for (std::size_t p = 0; p < count; ++p) {
+            dst[p] = static_cast<Accum>(coords[order_[p]]);
+        }
+    }
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::buildNode(const VertexStore<Real>& positions, std::size_t node,
+                                           std::size_t begin, std::size_t end) {
+    const std::size_t d = static_cast<std::size_t>(dims_);
+    const std::size_t count = end - begin;
+    Accum* center = centers_.data() + node * d;
+    Accum* lower = lower_.data() + node * d;
+    Accum* upper = upper_.data() + node * d;
+
+    Accum size = Accum(0);
+    int splitDim = 0;
+    for (std::size_t j = 0; j < d; ++j) {
+        auto coords = positions.plane(static_cast<int>(j));
+        Accum lo = std::numeric_limits<Accum>::max();
+        Accum hi = std::numeric_limits<Accum>::lowest();
+        Accum sum = Accum(0);
+        for (std::size_t p = begin; p < end; ++p) {
+            Accum c = coords[order_[p]];
+            lo = std::min(lo, c);
+            hi = std::max(hi, c);
+            sum += c;
+        }
+        lower[j] = lo;
+        upper[j] = hi;
+        center[j] = sum / static_cast<Accum>(count);
+        if (hi - lo > size) {
+            size = hi - lo;
+            splitDim = static_cast<int>(j);
+        }
+    }
+
+    Node& current = nodes_[node];
+    current.begin = static_cast<std::uint32_t>(begin);
+    current.end = static_cast<std::uint32_t>(end);
+    current.size = size;
+    if (count <= kLeafSize) {
+        current.right = -1;
+        return;
+    }
+
+    std::size_t mid = begin + count / 2;
+    auto coords = positions.plane(splitDim);
+    std::nth_element(order_.begin() + static_cast<std::ptrdiff_t>(begin),
+                     order_.begin() + static_cast<std::ptrdiff_t>(mid),
+                     order_.begin() + static_cast<std::ptrdiff_t>(end),
+                     [&coords](std::uint32_t a, std::uint32_t b) { return coords[a] < coords[b]; });
+
+    std::size_t leftNode = node + 1;
+    std::size_t rightNode = leftNode + countNodes(mid - begin);
+    current.right = static_cast<std::int32_t>(rightNode);
+
+    if (count > kTaskThreshold) {
+        #pragma omp task firstprivate(leftNode, begin, mid) shared(positions)
+        buildNode(positions, leftNode, begin, mid);
+        #pragma omp task firstprivate(rightNode, mid, end) shared(positions)
+        buildNode(positions, rightNode, mid, end);
+        #pragma omp taskwait
+    } else {
+        buildNode(positions, leftNode, begin, mid);
+        buildNode(positions, rightNode, mid, end);
+    }
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::computeAccelerations(const VertexStore<Real>& positions, Accum influence,
+                                                      Accum openingAngle, VertexStore<Accum>& out) const {
+    #pragma omp parallel
+    computeAccelerationsTeam(positions, influence, openingAngle, out);
+}
+
+template<typename Real, typename Accum>
+void BarnesHutTree<Real, Accum>::computeAccelerationsTeam(const VertexStore<Real>& positions, Accum influence,
+                                                          Accum openingAngle, VertexStore<Accum>& out) const {
+    const std::size_t count = positions.size();
+    const std::size_t d = static_cast<std::size_t>(dims_);
+    #pragma omp single
+    out.resize(count, dims_);
+    if (nodes_.empty() || count != order_.size() || sorted_.size() != count * d) {
+        #pragma omp single
+        for (int j = 0; j < out.dimensions(); ++j) {
+            std::ranges::fill(out.plane(j), Accum(0));
+        }
+        return;
+    }
+    // Traversal specialised for the dimension count, so the per-node coordinate loops have fixed trip counts
+    static constexpr auto kTraversals = makeDimensionTable(
+        [](auto dims) { return &BarnesHutTree::template traverseTeam<decltype(dims)::value>; });
+    (this->*kTraversals[dimensionSlot(dims_)])(influence, openingAngle * openingAngle, out);
+}
+
+template<typename Real, typename Accum>
+template<int Dims>
+void BarnesHutTree<Real, Accum>::traverseTeam(Accum influence, Accum theta2, VertexStore<Accum>& out) const {
+    const std::size_t count = order_.size();
+    const std::size_t d = activeDimensions<Dims>(static_cast<std::size_t>(dims_));
+
+    // Vertices are visited in tree order so consecutive iterations share most of their traversal
+    #pragma omp for schedule(dynamic, 64)
+    for (std::size_t q = 0; q < count; ++q) {
+        std::array<Accum, dimensionCapacity<Dims>> xi{};
+        std::array<Accum, dimensionCapacity<Dims>> acc{};
+        for (std::size_t j = 0; j < d; ++j) {
+            xi[j] = sorted_[j * count + q];
+        }
+
+        std::array<std::uint32_t, 128> stack;
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const std::uint32_t n = stack[--top];
+            const Node& node = nodes_[n];
+            if (node.right < 0) {
+                for (std::size_t p = node.begin; p < node.end; ++p) {
+                    if (p == q) continue;
+                    std::array<Accum, dimensionCapacity<Dims>> diff;
+                    Accum dist2 = Accum(0);
+                    for (std::size_t j = 0; j < d; ++j) {
+                        diff[j] = sorted_[j * count + p] - xi[j];
+                        dist2 += diff[j] * diff[j];
+                    }
+                    if (!(dist2 > Accum(0))) continue; // Coincident vertices exert no directed force
+                    Accum dist = std::sqrt(dist2);
+                    Accum scale = influence / (dist2 * dist);
+                    for (std::size_t j = 0; j < d; ++j) {
+                        acc[j] += scale * diff[j];
+                    }
+                }
+                continue;
+            }
+
+            const Accum* center = centers_.data() + static_cast<std::size_t>(n) * d;
+            const Accum* lower = lower_.data() + static_cast<std::size_t>(n) * d;
+            const Accum* upper = upper_.data() + static_cast<std::size_t>(n) * d;
+            bool inside = true;
+            Accum dist2 = Accum(0);
+            for (std::size_t j = 0; j < d; ++j) {
+                Accum diff = center[j] - xi[j];
+                dist2 += diff * diff;
+                inside = inside && xi[j] >= lower[j] && xi[j] <= upper[j];
+            }
+            if (!inside && node.size * node.size < theta2 * dist2) {
+                Accum dist = std::sqrt(dist2);
+                Accum scale = influence * static_cast<Accum>(node.end - node.begin) / (dist2 * dist);
+                for (std::size_t j = 0; j < d; ++j) {
+                    acc[j] += scale * (center[j] - xi[j]);
+                }
+            } else {
+                stack[top++] = static_cast<std::uint32_t>(node.right);
+                stack[top++] = n + 1;
+            }
+        }
+
+        const std::uint32_t i = order_[q];
+        for (std::size_t j = 0; j < d; ++j) {
+            out.plane(static_cast<int>(j))[i] = acc[j];
+        }
+    }
+}
+
+template class BarnesHutTree<long double, long double>;
+template class BarnesHutTree<double, double>;
+template class BarnesHutTree<float, float>;
+template class BarnesHutTree<float, double>;
+
+} // namespace UE
@@ -0,0 +1,358 @@
+// ue_checkpoint.cpp
+// AMOURANTH RTX Engine, October 2025 - Binary checkpoint format for UniversalEquation.
+// Checksums, chunked LZ4/Zstd codecs, atomic file writes and the mapped reader.
+// Dependencies: OpenMP, ue_checkpoint.hpp, C++20 standard library; optionally liblz4 and libzstd.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_checkpoint.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <omp.h>
+
+#ifdef UE_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef UE_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace UE {
+
+static_assert(std::is_trivially_copyable_v<CheckpointHeader> && std::is_standard_layout_v<CheckpointHeader>,
+              "CheckpointHeader is written as raw bytes");
+static_assert(offsetof(CheckpointHeader, headerChecksum) == 224, "CheckpointHeader layout is part of the format");
+
+namespace {
+
+constexpr std::size_t kChecksumBlock = std::size_t(1) << 20;
+constexpr std::uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+constexpr std::uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::uint64_t rotl(std::uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+std::uint64_t load64(const std::byte* p) noexcept {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::uint64_t avalanche(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime1;
+    h ^= h >> 32;
+    return h;
+}
+
+// Four interleaved multiply-rotate lanes over 8-byte words, then the tail and the length
+std::uint64_t hashBlock(const std::byte* p, std::size_t bytes, std::uint64_t seed) noexcept {
+    std::uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+    std::size_t offset = 0;
+    for (; offset + 32 <= bytes; offset += 32) {
+        for (int l = 0; l < 4; ++l) {
+            lanes[l] = rotl(lanes[l] + load64(p + offset + 8 * l) * kPrime2, 31) * kPrime1;
+        }
+    }
+    std::uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    for (; offset + 8 <= bytes; offset += 8) {
+        h = rotl(h ^ (load64(p + offset) * kPrime2), 27) * kPrime1;
+    }
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, p + offset, bytes - offset);
+    h = rotl(h ^ (tail * kPrime1), 23) * kPrime2;
+    return avalanche(h ^ static_cast<std::uint64_t>(bytes));
+}
+
+// Returns false on failure; never throws, so it can run inside a parallel loop
+bool compressChunk(CheckpointCompression codec, [[maybe_unused]] int level,
+                   [[maybe_unused]] std::span<const std::byte> in, [[maybe_unused]] std::vector<std::byte>& out) {
+    switch (codec) {
+#ifdef UE_HAVE_LZ4
+    case CheckpointCompression::LZ4: {
+        out.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(in.size()))));
+        const int written = LZ4_compress_default(reinterpret_cast<const char*>(in.data()),
+                                                 reinterpret_cast<char*>(out.data()), static_cast<int>(in.size()),
+                                                 static_cast<int>(out.size()));
+        out.resize(static_cast<std::size_t>(std::max(written, 0)));
+        return written > 0;
+    }
+#endif
+#ifdef UE_HAVE_ZSTD
+    case CheckpointCompression::Zstd: {
+        out.resize(ZSTD_compressBound(in.size()));
+        const std::size_t written = ZSTD_compress(out.data(), out.size(), in.data(), in.size(), level);
+        if (ZSTD_isError(written)) {
+            return false;
+        }
+        out.resize(written);
+        return true;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+bool decompressChunk(CheckpointCompression codec, [[maybe_unused]] std::span<const std::byte> in,
+                     [[maybe_unused]] std::span<std::byte> out) {
+    switch (codec) {
+#ifdef UE_HAVE_LZ4
+    case CheckpointCompression::LZ4:
+        return LZ4_decompress_safe(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()),
+                                   static_cast<int>(in.size()), static_cast<int>(out.size())) ==
+               static_cast<int>(out.size());
+#endif
+#ifdef UE_HAVE_ZSTD
+    case CheckpointCompression::Zstd: {
+        const std::size_t written = ZSTD_decompress(out.data(), out.size(), in.data(), in.size());
+        return !ZSTD_isError(written) && written == out.size();
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+std::uint64_t checkpointChecksum(const void* data, std::size_t bytes) noexcept {
+    const auto* p = static_cast<const std::byte*>(data);
+    if (bytes <= kChecksumBlock) {
+        return hashBlock(p, bytes, 0);
+    }
+    // Block hashes are combined in a fixed order, so the result does not depend on the thread count
+    const std::size_t blocks = (bytes + kChecksumBlock - 1) / kChecksumBlock;
+    std::vector<std::uint64_t> hashes(blocks);
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t begin = b * kChecksumBlock;
+        hashes[b] = hashBlock(p + begin, std::min(kChecksumBlock, bytes - begin), b);
+    }
+    return hashBlock(reinterpret_cast<const std::byte*>(hashes.data()), blocks * sizeof(std::uint64_t), bytes);
+}
+
+bool compressionAvailable(CheckpointCompression codec) noexcept {
+    switch (codec) {
+    case CheckpointCompression::None:
+        return true;
+    case CheckpointCompression::LZ4:
+#ifdef UE_HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case CheckpointCompression::Zstd:
+#ifdef UE_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+// Stored form of a compressed section: chunk count, stored size of every chunk, then the chunks
+std::vector<std::byte> compressChunks(CheckpointCompression codec, int level, std::span<const std::byte> raw) {
+    if (codec == CheckpointCompression::None || !compressionAvailable(codec)) {
+        throw std::invalid_argument("compressChunks: compression is not available in this build");
+    }
+    const std::size_t chunks = (raw.size() + kCheckpointChunk - 1) / kCheckpointChunk;
+    std::vector<std::vector<std::byte>> packed(chunks);
+    std::atomic<bool> failed{false};
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::size_t c = 0; c < chunks; ++c) {
+        const std::size_t begin = c * kCheckpointChunk;
+        const std::size_t size = std::min(kCheckpointChunk, raw.size() - begin);
+        if (!compressChunk(codec, level, raw.subspan(begin, size), packed[c])) {
+            failed.store(true);
+        }
+    }
+    if (failed.load()) {
+        throw std::runtime_error("compressChunks: compression failed");
+    }
+    std::vector<std::uint64_t> table(chunks + 1);
+    table[0] = chunks;
+    std::size_t total = table.size() * sizeof(std::uint64_t);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        table[c + 1] = packed[c].size();
+        total += packed[c].size();
+    }
+    std::vector<std::byte> out(total);
+    std::memcpy(out.data(), table.data(), table.size() * sizeof(std::uint64_t));
+    std::size_t offset = table.size() * sizeof(std::uint64_t);
+    for (const auto& chunk : packed) {
+        std::memcpy(out.data() + offset, chunk.data(), chunk.size());
+        offset += chunk.size();
+    }
+    return out;
+}
+
+void decompressChunks(CheckpointCompression codec, std::span<const std::byte> stored, std::span<std::byte> out) {
+    const std::size_t chunks = (out.size() + kCheckpointChunk - 1) / kCheckpointChunk;
+    const std::size_t tableBytes = (chunks + 1) * sizeof(std::uint64_t);
+    if (stored.size() < tableBytes || load64(stored.data()) != chunks) {
+        throw std::runtime_error("corrupt chunk table");
+    }
+    std::vector<std::size_t> starts(chunks + 1, tableBytes);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        starts[c + 1] = starts[c] + static_cast<std::size_t>(load64(stored.data() + (c + 1) * sizeof(std::uint64_t)));
+    }
+    if (starts[chunks] > stored.size()) {
+        throw std::runtime_error("corrupt chunk table");
+    }
+    std::atomic<bool> failed{false};
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::size_t c = 0; c < chunks; ++c) {
+        const std::size_t begin = c * kCheckpointChunk;
+        if (!decompressChunk(codec, stored.subspan(starts[c], starts[c + 1] - starts[c]),
+                             out.subspan(begin, std::min(kCheckpointChunk, out.size() - begin)))) {
+            failed.store(true);
+        }
+    }
+    if (failed.load()) {
+        throw std::runtime_error("decompression failed");
+    }
+}
+
+void writeCheckpoint(const std::string& path, CheckpointHeader header,
+                     const std::array<std::span<const std::byte>, kCheckpointSections>& sections,
+                     const CheckpointOptions& options) {
+    if (!compressionAvailable(options.compression)) {
+        throw std::invalid_argument("writeCheckpoint: requested compression is not available in this build");
+    }
+    std::array<std::vector<std::byte>, kCheckpointSections> packed;
+    std::array<std::span<const std::byte>, kCheckpointSections> stored = sections;
+    if (options.compression != CheckpointCompression::None) {
+        for (std::size_t s = 0; s < kCheckpointSections; ++s) {
+            packed[s] = compressChunks(options.compression, options.level, sections[s]);
+            stored[s] = packed[s];
+        }
+    }
+
+    header.magic = kCheckpointMagic;
+    header.version = kCheckpointVersion;
+    header.compression = static_cast<std::uint32_t>(options.compression);
+    std::size_t offset = alignUp(sizeof(CheckpointHeader), kCheckpointAlignment);
+    for (std::size_t s = 0; s < kCheckpointSections; ++s) {
+        header.sections[s] = {offset, stored[s].size(), sections[s].size(),
+                              checkpointChecksum(stored[s].data(), stored[s].size())};
+        offset = alignUp(offset + stored[s].size(), kCheckpointAlignment);
+    }
+    header.headerChecksum = checkpointChecksum(&header, offsetof(CheckpointHeader, headerChecksum));
+
+    const std::string partial = path + ".partial";
+    {
+        std::ofstream file(partial, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("writeCheckpoint: cannot open " + partial);
+        }
+        const std::vector<char> padding(kCheckpointAlignment, 0);
+        auto padTo = [&](std::size_t position) {
+            const auto current = static_cast<std::size_t>(file.tellp());
+            file.write(padding.data(), static_cast<std::streamsize>(position - current));
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (std::size_t s = 0; s < kCheckpointSections; ++s) {
+            padTo(header.sections[s].offset);
+            file.write(reinterpret_cast<const char*>(stored[s].data()), static_cast<std::streamsize>(stored[s].size()));
+        }
+        padTo(offset);
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("writeCheckpoint: write failed for " + partial);
+        }
+    }
+    std::filesystem::rename(partial, path);
+}
+
+CheckpointFile::CheckpointFile(const std::string& path) : path_(path) {
+    bytes_ = static_cast<std::size_t>(std::filesystem::file_size(path));
+    if (bytes_ < sizeof(CheckpointHeader)) {
+        throw std::runtime_error("CheckpointFile: " + path + " is too small to be a checkpoint");
+    }
+    data_ = static_cast<const std::byte*>(MappedPages::mapFile(path, 0, bytes_, false));
+    header_ = reinterpret_cast<const CheckpointHeader*>(data_);
+    const char* problem = nullptr;
+    if (header_->magic != kCheckpointMagic) {
+        problem = "not a checkpoint";
+    } else if (header_->version != kCheckpointVersion) {
+        problem = "unsupported checkpoint version";
+    } else if (header_->headerChecksum != checkpointChecksum(header_, offsetof(CheckpointHeader, headerChecksum))) {
+        problem = "header checksum mismatch";
+    } else if (!compressionAvailable(static_cast<CheckpointCompression>(header_->compression))) {
+        problem = "compressed with a codec that is not available in this build";
+    } else {
+        for (const CheckpointSectionEntry& entry : header_->sections) {
+            if (entry.offset % kCheckpointAlignment != 0 || entry.offset > bytes_ ||
+                entry.storedBytes > bytes_ - entry.offset ||
+                (!compressed() && entry.storedBytes != entry.rawBytes)) {
+                problem = "section outside the file";
+                break;
+            }
+        }
+    }
+    if (problem) {
+        MappedPages::unmap(const_cast<std::byte*>(data_), bytes_);
+        throw std::runtime_error("CheckpointFile: " + path + ": " + problem);
+    }
+}
+
+CheckpointFile::~CheckpointFile() {
+    MappedPages::unmap(const_cast<std::byte*>(data_), bytes_);
+}
+
+void CheckpointFile::verify() const {
+    static constexpr const char* kNames[kCheckpointSections] = {"params", "positions", "momenta", "spins",
+                                                                "amplitudes"};
+    for (std::size_t s = 0; s < kCheckpointSections; ++s) {
+        const auto section = stored(static_cast<CheckpointSection>(s));
+        if (checkpointChecksum(section.data(), section.size()) != header_->sections[s].checksum) {
+            throw std::runtime_error("CheckpointFile: " + path_ + ": checksum mismatch in section " + kNames[s]);
+        }
+    }
+}
+
+std::span<const std::byte> CheckpointFile::stored(CheckpointSection section) const noexcept {
+    const CheckpointSectionEntry& entry = header_->sections[section];
+    return {data_ + entry.offset, static_cast<std::size_t>(entry.storedBytes)};
+}
+
+void CheckpointFile::read(CheckpointSection section, std::span<std::byte> out) const {
+    const CheckpointSectionEntry& entry = header_->sections[section];
+    if (out.size() != entry.rawBytes) {
+        throw std::invalid_argument("CheckpointFile::read: output size does not match the section");
+    }
+    const std::span<const std::byte> in = stored(section);
+    const std::size_t chunks = (out.size() + kCheckpointChunk - 1) / kCheckpointChunk;
+    if (!compressed()) {
+        #pragma omp parallel for schedule(static)
+        for (std::size_t c = 0; c < chunks; ++c) {
+            const std::size_t begin = c * kCheckpointChunk;
+            std::memcpy(out.data() + begin, in.data() + begin, std::min(kCheckpointChunk, out.size() - begin));
+        }
+        return;
+    }
+
+    try {
+        decompressChunks(static_cast<CheckpointCompression>(header_->compression), in, out);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("CheckpointFile: " + path_ + ": " + e.what());
+    }
+}
+
+} // namespace UE
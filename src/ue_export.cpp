@@ -0,0 +1,428 @@
+// ue_export.cpp
+// AMOURANTH RTX Engine, October 2025 - Result export for UniversalEquation.
+// The buffered CSV formatter and the Arrow IPC stream encoder. Arrow metadata is a flatbuffer; the few tables it
+// needs are built here by hand rather than pulling in the flatbuffers and Arrow libraries.
+// Dependencies: ue_export.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_export.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+
+namespace UE {
+
+namespace {
+
+// Arrow format constants (format/Schema.fbs and format/Message.fbs)
+constexpr std::int16_t kArrowMetadataV5 = 4;
+constexpr std::uint8_t kArrowHeaderSchema = 1;
+constexpr std::uint8_t kArrowHeaderRecordBatch = 3;
+constexpr std::uint8_t kArrowTypeInt = 2;
+constexpr std::uint8_t kArrowTypeFloatingPoint = 3;
+constexpr std::int16_t kArrowPrecisionDouble = 2;
+constexpr std::uint32_t kArrowContinuation = 0xFFFFFFFFu;
+constexpr std::size_t kArrowAlignment = 8;
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Minimal flatbuffer builder. Like the reference implementation it builds back to front, so children are finished
+// before the tables that point at them and every offset points forward. Positions are byte counts from the end of
+// the buffer.
+class FlatBuilder {
+public:
+    std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(bytes_.size()); }
+
+    template<typename T>
+    void push(T value) {
+        align(sizeof(T), sizeof(T));
+        prepend(&value, sizeof(T));
+    }
+
+    void pushOffset(std::uint32_t target) {
+        align(sizeof(std::uint32_t), sizeof(std::uint32_t));
+        push<std::uint32_t>(size() + sizeof(std::uint32_t) - target);
+    }
+
+    std::uint32_t string(std::string_view text) {
+        align(text.size() + 1, sizeof(std::uint32_t));
+        const char terminator = '\0';
+        prepend(&terminator, 1);
+        prepend(text.data(), text.size());
+        push<std::uint32_t>(static_cast<std::uint32_t>(text.size()));
+        return size();
+    }
+
+    std::uint32_t offsetVector(const std::vector<std::uint32_t>& targets) {
+        align(sizeof(std::uint32_t) * (targets.size() + 1), sizeof(std::uint32_t));
+        for (auto it = targets.rbegin(); it != targets.rend(); ++it) pushOffset(*it);
+        push<std::uint32_t>(static_cast<std::uint32_t>(targets.size()));
+        return size();
+    }
+
+    // Vector of structs made of int64 fields (FieldNode, Buffer)
+    std::uint32_t structVector(const std::vector<std::int64_t>& fields, std::size_t fieldsPerStruct) {
+        align(fields.size() * sizeof(std::int64_t), sizeof(std::int64_t));
+        for (auto it = fields.rbegin(); it != fields.rend(); ++it) push(*it);
+        push<std::uint32_t>(static_cast<std::uint32_t>(fields.size() / fieldsPerStruct));
+        return size();
+    }
+
+    void startTable() {
+        fields_.clear();
+        tableStart_ = size();
+    }
+
+    template<typename T>
+    void addScalar(std::uint16_t id, T value) {
+        push(value);
+        fields_.push_back({id, size()});
+    }
+
+    void addOffset(std::uint16_t id, std::uint32_t target) {
+        pushOffset(target);
+        fields_.push_back({id, size()});
+    }
+
+    std::uint32_t endTable() {
+        push<std::int32_t>(0); // Offset to the vtable, patched below
+        const std::uint32_t table = size();
+        std::uint16_t slots = 0;
+        for (const auto& field : fields_) slots = std::max<std::uint16_t>(slots, field.id + 1);
+        std::vector<std::uint16_t> vtable(slots, 0);
+        for (const auto& field : fields_) vtable[field.id] = static_cast<std::uint16_t>(table - field.position);
+        for (auto it = vtable.rbegin(); it != vtable.rend(); ++it) push(*it);
+        push<std::uint16_t>(static_cast<std::uint16_t>(table - tableStart_));
+        push<std::uint16_t>(static_cast<std::uint16_t>(sizeof(std::uint16_t) * (slots + 2)));
+        const std::int32_t toVtable = static_cast<std::int32_t>(size() - table);
+        std::memcpy(bytes_.data() + (size() - table), &toVtable, sizeof(toVtable));
+        return table;
+    }
+
+    std::vector<std::byte> finish(std::uint32_t root) {
+        align(sizeof(std::uint32_t), maxAlign_);
+        pushOffset(root);
+        return std::move(bytes_);
+    }
+
+private:
+    struct Field {
+        std::uint16_t id;
+        std::uint32_t position;
+    };
+
+    // Pads so that, after bytes more are prepended, the front is aligned
+    void align(std::size_t bytes, std::size_t alignment) {
+        maxAlign_ = std::max(maxAlign_, alignment);
+        const std::size_t padding = (alignment - (bytes_.size() + bytes) % alignment) % alignment;
+        bytes_.insert(bytes_.begin(), padding, std::byte{0});
+    }
+
+    void prepend(const void* data, std::size_t bytes) {
+        const auto* first = static_cast<const std::byte*>(data);
+        bytes_.insert(bytes_.begin(), first, first + bytes);
+    }
+
+    std::vector<std::byte> bytes_;
+    std::vector<Field> fields_;
+    std::uint32_t tableStart_ = 0;
+    std::size_t maxAlign_ = 1;
+};
+
+// Message table around a finished header; returns the encapsulated message, ready for its body
+std::vector<std::byte> arrowMessage(FlatBuilder& builder, std::uint8_t headerType, std::uint32_t header,
+                                    std::int64_t bodyLength) {
+    builder.startTable();
+    builder.addScalar<std::int64_t>(3, bodyLength);
+    builder.addOffset(2, header);
+    builder.addScalar<std::int16_t>(0, kArrowMetadataV5);
+    builder.addScalar<std::uint8_t>(1, headerType);
+    const std::vector<std::byte> metadata = builder.finish(builder.endTable());
+
+    // Continuation marker and metadata length, padded so the body starts aligned
+    const std::size_t metadataBytes = alignUp(metadata.size(), kArrowAlignment);
+    std::vector<std::byte> message(2 * sizeof(std::uint32_t) + metadataBytes, std::byte{0});
+    const std::uint32_t length = static_cast<std::uint32_t>(metadataBytes);
+    std::memcpy(message.data(), &kArrowContinuation, sizeof(kArrowContinuation));
+    std::memcpy(message.data() + sizeof(std::uint32_t), &length, sizeof(length));
+    std::memcpy(message.data() + 2 * sizeof(std::uint32_t), metadata.data(), metadata.size());
+    return message;
+}
+
+std::string csvHeader(const std::vector<ExportColumn>& columns) {
+    std::string header;
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (i > 0) header += ',';
+        header += columns[i].name;
+    }
+    return header;
+}
+
+std::size_t columnBytes(ExportType type) noexcept {
+    return type == ExportType::Int32 ? sizeof(std::int32_t) : sizeof(double);
+}
+
+} // namespace
+
+ResultWriter::ResultWriter(const std::string& path, std::vector<ExportColumn> columns, const ExportOptions& options)
+    : path_(path), columns_(std::move(columns)), options_(options) {
+    if (columns_.empty() || options.batchRows == 0 || options.precision > 1000) {
+        throw std::invalid_argument("ResultWriter: invalid columns or options");
+    }
+    const bool csv = options.format == ExportFormat::Csv;
+    if (!csv && std::endian::native != std::endian::little) {
+        throw std::invalid_argument("ResultWriter: Arrow export needs a little-endian host");
+    }
+
+    std::error_code ec;
+    const bool append = options.mode == ExportMode::Append && std::filesystem::file_size(path, ec) > 0 && !ec;
+    const std::vector<std::byte> schema = csv ? std::vector<std::byte>{} : schemaMessage();
+    if (append) {
+        // Only rows of the same layout may be added
+        std::ifstream existing(path, std::ios::binary);
+        bool matches = false;
+        if (csv) {
+            std::string line;
+            std::getline(existing, line);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            matches = line == csvHeader(columns_);
+        } else {
+            std::vector<std::byte> head(schema.size());
+            matches = existing.read(reinterpret_cast<char*>(head.data()), static_cast<std::streamsize>(head.size())) &&
+                      head == schema;
+            // Strip the end-of-stream marker; the stream continues with the new batches
+            std::uint32_t tail[2] = {};
+            const auto bytes = std::filesystem::file_size(path);
+            if (matches && bytes >= schema.size() + sizeof(tail) &&
+                existing.seekg(static_cast<std::streamoff>(bytes - sizeof(tail))) &&
+                existing.read(reinterpret_cast<char*>(tail), sizeof(tail)) && tail[0] == kArrowContinuation &&
+                tail[1] == 0) {
+                existing.close();
+                std::filesystem::resize_file(path, bytes - sizeof(tail));
+            }
+        }
+        if (!matches) {
+            throw std::invalid_argument("ResultWriter: " + path + " does not have the requested columns");
+        }
+    }
+
+    file_.open(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if (!file_.is_open()) {
+        throw std::runtime_error("ResultWriter: cannot open " + path);
+    }
+    if (csv) {
+        // Room for any long double in fixed notation, so a value always fits after a flush
+        text_.resize(std::max<std::size_t>(options.bufferBytes, 16384));
+        if (!append) {
+            for (char c : csvHeader(columns_)) putText(c);
+            putText('\n');
+        }
+    } else {
+        ints_.resize(columns_.size());
+        doubles_.resize(columns_.size());
+        for (std::size_t i = 0; i < columns_.size(); ++i) {
+            if (columns_[i].type == ExportType::Int32) ints_[i].reserve(options.batchRows);
+            else doubles_[i].reserve(options.batchRows);
+        }
+        if (!append) file_.write(reinterpret_cast<const char*>(schema.data()), static_cast<std::streamsize>(schema.size()));
+    }
+    if (!file_) {
+        throw std::runtime_error("ResultWriter: write failed for " + path);
+    }
+}
+
+ResultWriter::~ResultWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to see write errors
+    }
+}
+
+void ResultWriter::checkColumn(ExportType type) const {
+    if (closed_) {
+        throw std::logic_error("ResultWriter: " + path_ + " is closed");
+    }
+    if (column_ >= columns_.size()) {
+        throw std::logic_error("ResultWriter: row already has every column");
+    }
+    if (columns_[column_].type != type) {
+        throw std::invalid_argument("ResultWriter: wrong value type for column " + columns_[column_].name);
+    }
+}
+
+void ResultWriter::putText(char c) {
+    if (textUsed_ == text_.size()) flushText();
+    text_[textUsed_++] = c;
+}
+
+void ResultWriter::flushText() {
+    file_.write(text_.data(), static_cast<std::streamsize>(textUsed_));
+    textUsed_ = 0;
+    if (!file_) {
+        throw std::runtime_error("ResultWriter: write failed for " + path_);
+    }
+}
+
+void ResultWriter::value(std::int32_t v) {
+    checkColumn(ExportType::Int32);
+    if (options_.format == ExportFormat::Csv) {
+        if (column_ > 0) putText(',');
+        if (text_.size() - textUsed_ < 16) flushText();
+        textUsed_ = std::to_chars(text_.data() + textUsed_, text_.data() + text_.size(), v).ptr - text_.data();
+    } else {
+        ints_[column_].push_back(v);
+    }
+    ++column_;
+}
+
+void ResultWriter::value(long double v) {
+    checkColumn(ExportType::Float64);
+    if (options_.format == ExportFormat::Csv) {
+        if (column_ > 0) putText(',');
+        // Results of double and float instances are widened doubles; formatting is exact, so those take the much
+        // faster double conversion and print the same digits
+        const auto narrow = static_cast<double>(v);
+        const bool exact = static_cast<long double>(narrow) == v || v != v;
+        const auto format = [&] {
+            char* first = text_.data() + textUsed_;
+            char* last = text_.data() + text_.size();
+            if (options_.precision < 0) {
+                return exact ? std::to_chars(first, last, narrow) : std::to_chars(first, last, v);
+            }
+            return exact ? std::to_chars(first, last, narrow, std::chars_format::fixed, options_.precision)
+                         : std::to_chars(first, last, v, std::chars_format::fixed, options_.precision);
+        };
+        auto result = format();
+        if (result.ec != std::errc{}) {
+            flushText();
+            result = format();
+            if (result.ec != std::errc{}) {
+                throw std::runtime_error("ResultWriter: cannot format value for column " + columns_[column_].name);
+            }
+        }
+        textUsed_ = static_cast<std::size_t>(result.ptr - text_.data());
+    } else {
+        doubles_[column_].push_back(static_cast<double>(v));
+    }
+    ++column_;
+}
+
+void ResultWriter::endRow() {
+    if (column_ != columns_.size()) {
+        throw std::logic_error("ResultWriter: row is missing columns");
+    }
+    column_ = 0;
+    ++rows_;
+    if (options_.format == ExportFormat::Csv) {
+        putText('\n');
+    } else if (++pendingRows_ == options_.batchRows) {
+        writeRecordBatch();
+    }
+}
+
+void ResultWriter::flush() {
+    if (closed_) return;
+    if (column_ != 0) {
+        throw std::logic_error("ResultWriter: cannot flush in the middle of a row");
+    }
+    if (options_.format == ExportFormat::Csv) flushText();
+    else writeRecordBatch();
+    file_.flush();
+    if (!file_) {
+        throw std::runtime_error("ResultWriter: write failed for " + path_);
+    }
+}
+
+void ResultWriter::close() {
+    if (closed_) return;
+    flush();
+    closed_ = true;
+    if (options_.format == ExportFormat::ArrowStream) {
+        const std::uint32_t endOfStream[2] = {kArrowContinuation, 0};
+        file_.write(reinterpret_cast<const char*>(endOfStream), sizeof(endOfStream));
+    }
+    file_.close();
+    if (!file_) {
+        throw std::runtime_error("ResultWriter: write failed for " + path_);
+    }
+}
+
+std::vector<std::byte> ResultWriter::schemaMessage() const {
+    FlatBuilder builder;
+    std::vector<std::uint32_t> fields;
+    for (const auto& column : columns_) {
+        const std::uint32_t name = builder.string(column.name);
+        const std::uint32_t children = builder.offsetVector({});
+        builder.startTable();
+        if (column.type == ExportType::Int32) {
+            builder.addScalar<std::int32_t>(0, 32);    // bitWidth
+            builder.addScalar<std::uint8_t>(1, 1);     // is_signed
+        } else {
+            builder.addScalar<std::int16_t>(0, kArrowPrecisionDouble);
+        }
+        const std::uint32_t type = builder.endTable();
+        builder.startTable();
+        builder.addOffset(0, name);
+        builder.addOffset(3, type);
+        builder.addOffset(5, children);
+        builder.addScalar<std::uint8_t>(1, 0); // nullable
+        builder.addScalar<std::uint8_t>(2, column.type == ExportType::Int32 ? kArrowTypeInt : kArrowTypeFloatingPoint);
+        fields.push_back(builder.endTable());
+    }
+    const std::uint32_t fieldVector = builder.offsetVector(fields);
+    builder.startTable();
+    builder.addOffset(1, fieldVector);
+    builder.addScalar<std::int16_t>(0, 0); // Little endian
+    return arrowMessage(builder, kArrowHeaderSchema, builder.endTable(), 0);
+}
+
+void ResultWriter::writeRecordBatch() {
+    if (pendingRows_ == 0) return;
+    const auto rows = static_cast<std::int64_t>(pendingRows_);
+
+    // Each column is a node with an empty validity buffer (no nulls) and a data buffer
+    std::vector<std::int64_t> nodes;
+    std::vector<std::int64_t> buffers;
+    std::int64_t bodyLength = 0;
+    for (const auto& column : columns_) {
+        const auto bytes = static_cast<std::int64_t>(pendingRows_ * columnBytes(column.type));
+        nodes.insert(nodes.end(), {rows, 0});
+        buffers.insert(buffers.end(), {bodyLength, 0, bodyLength, bytes});
+        bodyLength += static_cast<std::int64_t>(alignUp(static_cast<std::size_t>(bytes), kArrowAlignment));
+    }
+    FlatBuilder builder;
+    const std::uint32_t bufferVector = builder.structVector(buffers, 2);
+    const std::uint32_t nodeVector = builder.structVector(nodes, 2);
+    builder.startTable();
+    builder.addScalar<std::int64_t>(0, rows);
+    builder.addOffset(1, nodeVector);
+    builder.addOffset(2, bufferVector);
+    const std::vector<std::byte> message = arrowMessage(builder, kArrowHeaderRecordBatch, builder.endTable(), bodyLength);
+
+    file_.write(reinterpret_cast<const char*>(message.data()), static_cast<std::streamsize>(message.size()));
+    static constexpr char padding[kArrowAlignment] = {};
+    for (std::size_t i = 0; i < columns_.size(); ++i) {
+        const bool ints = columns_[i].type == ExportType::Int32;
+        const char* data = ints ? reinterpret_cast<const char*>(ints_[i].data())
+                                : reinterpret_cast<const char*>(doubles_[i].data());
+        const std::size_t bytes = pendingRows_ * columnBytes(columns_[i].type);
+        file_.write(data, static_cast<std::streamsize>(bytes));
+        file_.write(padding, static_cast<std::streamsize>(alignUp(bytes, kArrowAlignment) - bytes));
+        ints_[i].clear();
+        doubles_[i].clear();
+    }
+    pendingRows_ = 0;
+    if (!file_) {
+        throw std::runtime_error("ResultWriter: write failed for " + path_);
+    }
+}
+
+} // namespace UE
@@ -0,0 +1,209 @@
+// ue_gravity_kernel.cpp
+// AMOURANTH RTX Engine, October 2025 - Exact all-pairs gravity kernel for UniversalEquation.
+// Symmetric tile-pair evaluation with SIMD inner loops and a conflict-free round-robin tile schedule.
+// Dependencies: OpenMP, ue_gravity_kernel.hpp, ue_dimension_dispatch.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_gravity_kernel.hpp"
+#include "ue_dimension_dispatch.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <omp.h>
+
+#if __has_include(<experimental/simd>)
+// libstdc++'s AVX-512 sqrt passes an unset merge operand to a fully-masked intrinsic
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <experimental/simd>
+#pragma GCC diagnostic pop
+#define UE_HAS_STDX_SIMD 1
+#else
+#define UE_HAS_STDX_SIMD 0
+#endif
+
+namespace UE {
+
+namespace {
+
+constexpr std::size_t kMaxDims = 19;
+
+template<typename Accum>
+using PlanePointers = std::array<const Accum*, kMaxDims>;
+template<typename Accum>
+using AccelPointers = std::array<Accum*, kMaxDims>;
+
+template<int Dims, typename Accum>
+using Coordinates = std::array<Accum, dimensionCapacity<Dims>>;
+
+// Applies the pair (i, j) to both vertices; coincident vertices exert no directed force
+template<int Dims, typename Accum>
+inline void scalarPair(const PlanePointers<Accum>& x, const AccelPointers<Accum>& acc, std::size_t d,
+                       Accum influence, const Coordinates<Dims, Accum>& xi, Coordinates<Dims, Accum>& ai,
+                       std::size_t j) {
+    Coordinates<Dims, Accum> diff;
+    Accum dist2 = Accum(0);
+    for (std::size_t k = 0; k < d; ++k) {
+        diff[k] = x[k][j] - xi[k];
+        dist2 += diff[k] * diff[k];
+    }
+    if (!(dist2 > Accum(0))) return;
+    Accum scale = influence / (dist2 * std::sqrt(dist2));
+    for (std::size_t k = 0; k < d; ++k) {
+        Accum f = scale * diff[k];
+        ai[k] += f;
+        acc[k][j] -= f;
+    }
+}
+
+// Evaluates every pair between [iBegin, iEnd) and [jBegin, jEnd). For a diagonal block both ranges are the
+// same tile and only j > i is visited. Instantiated per dimension count (0 = runtime count).
+template<int Dims, typename Accum>
+void pairBlock(const PlanePointers<Accum>& x, const AccelPointers<Accum>& acc, std::size_t dRuntime, Accum influence,
+               std::size_t iBegin, std::size_t iEnd, std::size_t jBegin, std::size_t jEnd, bool diagonal) {
+    const std::size_t d = activeDimensions<Dims>(dRuntime);
+    for (std::size_t i = iBegin; i < iEnd; ++i) {
+        Coordinates<Dims, Accum> xi{};
+        Coordinates<Dims, Accum> ai{};
+        for (std::size_t k = 0; k < d; ++k) {
+            xi[k] = x[k][i];
+        }
+        std::size_t j = diagonal ? i + 1 : jBegin;
+
+#if UE_HAS_STDX_SIMD
+        namespace stdx = std::experimental;
+        using V = stdx::native_simd<Accum>;
+        constexpr std::size_t W = V::size();
+        if constexpr (W > 1) {
+            std::array<V, dimensionCapacity<Dims>> av{};
+            for (; j + W <= jEnd; j += W) {
+                std::array<V, dimensionCapacity<Dims>> diff;
+                V dist2(Accum(0));
+                for (std::size_t k = 0; k < d; ++k) {
+                    diff[k] = V(x[k] + j, stdx::element_aligned) - V(xi[k]);
+                    dist2 += diff[k] * diff[k];
+                }
+                const auto valid = dist2 > V(Accum(0));
+                V safe = dist2;
+                stdx::where(!valid, safe) = V(Accum(1));
+                V scale = V(influence) / (safe * stdx::sqrt(safe));
+                stdx::where(!valid, scale) = V(Accum(0));
+                for (std::size_t k = 0; k < d; ++k) {
+                    V f = scale * diff[k];
+                    av[k] += f;
+                    V aj(acc[k] + j, stdx::element_aligned);
+                    aj -= f;
+                    aj.copy_to(acc[k] + j, stdx::element_aligned);
+                }
+            }
+            for (std::size_t k = 0; k < d; ++k) {
+                ai[k] += stdx::reduce(av[k]);
+            }
+        }
+#endif
+
+        for (; j < jEnd; ++j) {
+            scalarPair<Dims>(x, acc, d, influence, xi, ai, j);
+        }
+        for (std::size_t k = 0; k < d; ++k) {
+            acc[k][i] += ai[k];
+        }
+    }
+}
+
+// Circle-method pairing: slot 0 is fixed and the remaining slots rotate one step per round
+inline std::size_t slotTile(std::size_t slot, std::size_t round, std::size_t slots) {
+    return slot == 0 ? 0 : (slot - 1 + round) % (slots - 1) + 1;
+}
+
+} // namespace
+
+template<typename Real, typename Accum>
+void PairwiseGravityKernel<Real, Accum>::compute(const VertexStore<Real>& positions, int dimensions,
+                                                 Accum influence, VertexStore<Accum>& out) {
+    #pragma omp parallel
+    computeTeam(positions, dimensions, influence, out);
+}
+
+template<typename Real, typename Accum>
+void PairwiseGravityKernel<Real, Accum>::computeTeam(const VertexStore<Real>& positions, int dimensions,
+                                                     Accum influence, VertexStore<Accum>& out) {
+    #pragma omp single
+    {
+        const int dims = std::clamp(std::min(dimensions, positions.dimensions()), 0, kMaxDimensions);
+        count_ = positions.size();
+        dims_ = static_cast<std::size_t>(dims);
+        out.resize(count_, dims);
+        if constexpr (std::is_same_v<Real, Accum>) {
+            for (int k = 0; k < dims; ++k) {
+                sources_[static_cast<std::size_t>(k)] = positions.plane(k).data();
+            }
+        } else {
+            converted_.resize(count_, dims);
+            for (int k = 0; k < dims; ++k) {
+                sources_[static_cast<std::size_t>(k)] = converted_.plane(k).data();
+            }
+        }
+        for (int k = 0; k < dims; ++k) {
+            targets_[static_cast<std::size_t>(k)] = out.plane(k).data();
+        }
+    }
+
+    const std::size_t count = count_;
+    const std::size_t d = dims_;
+    const auto& x = sources_;
+    const auto& acc = targets_;
+    for (std::size_t k = 0; k < d; ++k) {
+        auto coords = positions.plane(static_cast<int>(k));
+        Accum* widened = nullptr;
+        if constexpr (!std::is_same_v<Real, Accum>) {
+            widened = converted_.plane(static_cast<int>(k)).data();
+        }
+        Accum* target = acc[k];
+        #pragma omp for schedule(static) nowait
+        for (std::size_t i = 0; i < count; ++i) {
+            if constexpr (!std::is_same_v<Real, Accum>) {
+                widened[i] = static_cast<Accum>(coords[i]);
+            }
+            target[i] = Accum(0);
+        }
+    }
+    #pragma omp barrier
+    if (count < 2 || d == 0) {
+        return;
+    }
+
+    // Pair blocks specialised for the dimension count, so the per-pair coordinate loops have fixed trip counts
+    static constexpr auto kPairBlocks = makeDimensionTable([](auto dims) { return &pairBlock<decltype(dims)::value, Accum>; });
+    const auto pairBlockFor = kPairBlocks[dimensionSlot(static_cast<int>(d))];
+    const std::size_t tiles = (count + kTileSize - 1) / kTileSize;
+    const std::size_t slots = tiles + (tiles & 1); // Odd tile counts get a bye slot
+    const std::size_t rounds = slots - 1;
+    auto tileEnd = [count](std::size_t t) { return std::min(count, (t + 1) * kTileSize); };
+
+    // Diagonal blocks only touch their own tile
+    #pragma omp for schedule(dynamic, 1)
+    for (std::size_t t = 0; t < tiles; ++t) {
+        pairBlockFor(x, acc, d, influence, t * kTileSize, tileEnd(t), t * kTileSize, tileEnd(t), true);
+    }
+    // Each round pairs every tile with exactly one other, so blocks within a round write disjoint tiles
+    for (std::size_t r = 0; r < rounds; ++r) {
+        #pragma omp for schedule(dynamic, 1)
+        for (std::size_t s = 0; s < slots / 2; ++s) {
+            std::size_t a = slotTile(s, r, slots);
+            std::size_t b = slotTile(slots - 1 - s, r, slots);
+            if (a >= tiles || b >= tiles) continue;
+            if (a > b) std::swap(a, b);
+            pairBlockFor(x, acc, d, influence, a * kTileSize, tileEnd(a), b * kTileSize, tileEnd(b), false);
+        }
+    }
+}
+
+template class PairwiseGravityKernel<long double, long double>;
+template class PairwiseGravityKernel<double, double>;
+template class PairwiseGravityKernel<float, float>;
+template class PairwiseGravityKernel<float, double>;
+
+} // namespace UE
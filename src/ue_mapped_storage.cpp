@@ -0,0 +1,190 @@
+// ue_mapped_storage.cpp
+// AMOURANTH RTX Engine, October 2025 - Out-of-core vertex storage for UniversalEquation.
+// Creates, maps and advises the unlinked backing files of mapped vertex planes.
+// Dependencies: ue_mapped_storage.hpp, C++20 standard library; POSIX mmap on Linux, file mappings on Windows.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_mapped_storage.hpp"
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace UE {
+
+namespace {
+
+std::filesystem::path mappingDirectory(const std::string& directory) {
+    return directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(directory);
+}
+
+#ifndef _WIN32
+// Page-aligned cover of [address, address + bytes)
+std::pair<void*, std::size_t> pageSpan(const void* address, std::size_t bytes) noexcept {
+    const std::uintptr_t page = MappedPages::pageSize();
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(address) / page * page;
+    const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(address) + bytes + page - 1) / page * page;
+    return {reinterpret_cast<void*>(begin), static_cast<std::size_t>(end - begin)};
+}
+#endif
+
+} // namespace
+
+#ifdef _WIN32
+
+void* MappedPages::map(std::size_t bytes, const std::string& directory) {
+    const std::filesystem::path dir = mappingDirectory(directory);
+    char name[MAX_PATH];
+    if (GetTempFileNameA(dir.string().c_str(), "uev", 0, name) == 0) {
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(),
+                                "MappedPages: cannot create a backing file in " + dir.string());
+    }
+    HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(),
+                                std::string("MappedPages: cannot open ") + name);
+    }
+    const auto size = static_cast<unsigned long long>(bytes);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                        static_cast<DWORD>(size & 0xffffffffULL), nullptr);
+    void* address = mapping ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes) : nullptr;
+    const DWORD error = GetLastError();
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+    // The view keeps the section and file alive; the file is deleted once it is unmapped
+    CloseHandle(file);
+    if (!address) {
+        throw std::system_error(static_cast<int>(error), std::system_category(), "MappedPages: cannot map backing file");
+    }
+    return address;
+}
+
+void* MappedPages::mapFile(const std::string& path, std::size_t offset, std::size_t bytes, bool writable) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(),
+                                "MappedPages: cannot open " + path);
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    const auto start = static_cast<unsigned long long>(offset);
+    void* address = mapping ? MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ,
+                                            static_cast<DWORD>(start >> 32),
+                                            static_cast<DWORD>(start & 0xffffffffULL), bytes)
+                            : nullptr;
+    const DWORD error = GetLastError();
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (!address) {
+        throw std::system_error(static_cast<int>(error), std::system_category(), "MappedPages: cannot map " + path);
+    }
+    return address;
+}
+
+void MappedPages::unmap(void* address, std::size_t) noexcept {
+    if (address) {
+        UnmapViewOfFile(address);
+    }
+}
+
+void MappedPages::prefetch(const void*, std::size_t) noexcept {}
+
+void MappedPages::release(const void*, std::size_t) noexcept {}
+
+std::size_t MappedPages::pageSize() noexcept {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+#else
+
+void* MappedPages::map(std::size_t bytes, const std::string& directory) {
+    const std::string pattern = (mappingDirectory(directory) / "ue_vertices_XXXXXX").string();
+    std::vector<char> name(pattern.begin(), pattern.end());
+    name.push_back('\0');
+    const int fd = mkstemp(name.data());
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "MappedPages: cannot create " + pattern);
+    }
+    // Unlinked right away: the space is returned when the mapping goes, even after a crash
+    unlink(name.data());
+    if (const int error = posix_fallocate(fd, 0, static_cast<off_t>(bytes)); error != 0) {
+        close(fd);
+        throw std::system_error(error, std::generic_category(),
+                                "MappedPages: cannot reserve " + std::to_string(bytes) + " bytes in " + pattern);
+    }
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "MappedPages: mmap failed");
+    }
+    madvise(address, bytes, MADV_SEQUENTIAL);
+    return address;
+}
+
+void* MappedPages::mapFile(const std::string& path, std::size_t offset, std::size_t bytes, bool writable) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "MappedPages: cannot open " + path);
+    }
+    void* address = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd,
+                         static_cast<off_t>(offset));
+    const int error = errno;
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "MappedPages: cannot map " + path);
+    }
+    return address;
+}
+
+void MappedPages::unmap(void* address, std::size_t bytes) noexcept {
+    if (address) {
+        munmap(address, bytes);
+    }
+}
+
+void MappedPages::prefetch(const void* address, std::size_t bytes) noexcept {
+    if (bytes > 0) {
+        const auto [begin, length] = pageSpan(address, bytes);
+        madvise(begin, length, MADV_WILLNEED);
+    }
+}
+
+void MappedPages::release(const void* address, std::size_t bytes) noexcept {
+    if (bytes > 0) {
+        // Pages leave this process but stay in the file, so releasing never loses data
+        const auto [begin, length] = pageSpan(address, bytes);
+#ifdef MADV_PAGEOUT
+        if (madvise(begin, length, MADV_PAGEOUT) == 0) {
+            return;
+        }
+#endif
+        madvise(begin, length, MADV_DONTNEED);
+    }
+}
+
+std::size_t MappedPages::pageSize() noexcept {
+    static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+#endif
+
+} // namespace UE
@@ -0,0 +1,150 @@
+// ue_mean_field.cpp
+// AMOURANTH RTX Engine, October 2025 - Mean-field gravity for UniversalEquation.
+// Block-reduced moment fit and O(N) potential/acceleration evaluation, usable either standalone or as
+// worksharing inside a caller-owned parallel region.
+// Dependencies: OpenMP, ue_mean_field.hpp, ue_reduction.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_mean_field.hpp"
+#include "ue_reduction.hpp"
+#include <algorithm>
+#include <span>
+#include <omp.h>
+
+namespace UE {
+
+template<typename Real, typename Accum>
+void MeanFieldGravity<Real, Accum>::fit(const VertexStore<Real>& positions, int dimensions) {
+    #pragma omp parallel
+    fitTeam(positions, dimensions);
+}
+
+template<typename Real, typename Accum>
+void MeanFieldGravity<Real, Accum>::fitTeam(const VertexStore<Real>& positions, int dimensions) {
+    fitPositionsTeam(positions, dimensions);
+}
+
+template<typename Real, typename Accum>
+void MeanFieldGravity<Real, Accum>::fit(const ProceduralVertices<Real, Accum>& positions, int dimensions) {
+    #pragma omp parallel
+    fitPositionsTeam(positions, dimensions);
+}
+
+template<typename Real, typename Accum>
+template<typename Positions>
+void MeanFieldGravity<Real, Accum>::fitPositionsTeam(const Positions& positions, int dimensions) {
+    #pragma omp single
+    {
+        dims_ = std::clamp(std::min(dimensions, positions.dimensions()), 0, kMaxDimensions);
+        count_ = positions.size();
+        partials_.resize(reductionBlocks(count_) * kMaxDimensions);
+        centroid_.fill(Accum(0));
+        softening2_ = Accum(0);
+    }
+    const std::size_t count = count_;
+    const int d = dims_;
+    const std::size_t blocks = reductionBlocks(count);
+    if (count == 0 || d == 0) {
+        return;
+    }
+
+    // First pass: coordinate sums per block, plane-major so each plane folds as one contiguous span
+    #pragma omp for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t end = std::min(count, (b + 1) * kReductionBlock);
+        for (int k = 0; k < d; ++k) {
+            CompensatedSum<Accum> sum;
+            for (std::size_t i = b * kReductionBlock; i < end; ++i) {
+                sum.add(static_cast<Accum>(positions[i][static_cast<std::size_t>(k)]));
+            }
+            partials_[static_cast<std::size_t>(k) * blocks + b] = sum.value();
+        }
+    }
+    #pragma omp single
+    for (int k = 0; k < d; ++k) {
+        const std::span<const Accum> sums(partials_.data() + static_cast<std::size_t>(k) * blocks, blocks);
+        centroid_[static_cast<std::size_t>(k)] = pairwiseSum(sums) / static_cast<Accum>(count);
+    }
+
+    // Second pass: squared distances from the centroid, which is more stable than subtracting raw moments
+    #pragma omp for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t end = std::min(count, (b + 1) * kReductionBlock);
+        CompensatedSum<Accum> sum;
+        for (int k = 0; k < d; ++k) {
+            const Accum c = centroid_[static_cast<std::size_t>(k)];
+            for (std::size_t i = b * kReductionBlock; i < end; ++i) {
+                const Accum diff = static_cast<Accum>(positions[i][static_cast<std::size_t>(k)]) - c;
+                sum.add(diff * diff);
+            }
+        }
+        partials_[b] = sum.value();
+    }
+    #pragma omp single
+    softening2_ = pairwiseSum(std::span<const Accum>(partials_.data(), blocks)) / static_cast<Accum>(count);
+}
+
+template<typename Real, typename Accum>
+void MeanFieldGravity<Real, Accum>::blendAccelerationsTeam(const VertexStore<Real>& positions, Accum influence,
+                                                           Accum weight, VertexStore<Accum>& out) const {
+    const bool replace = !(weight < Accum(1));
+    if (replace) {
+        #pragma omp single
+        out.resize(count_, dims_);
+    }
+    const std::size_t count = std::min({count_, positions.size(), out.size()});
+    const int d = std::min(dims_, out.dimensions());
+    const Accum keep = Accum(1) - weight;
+    const Accum scaledMass = influence * mass();
+    #pragma omp for schedule(static)
+    for (std::size_t i = 0; i < count; ++i) {
+        std::array<Accum, kMaxDimensions> diff;
+        Accum r2 = softening2_;
+        for (int k = 0; k < d; ++k) {
+            diff[k] = centroid_[k] - static_cast<Accum>(positions.plane(k)[i]);
+            r2 += diff[k] * diff[k];
+        }
+        const Accum scale = r2 > Accum(0) ? scaledMass / (r2 * std::sqrt(r2)) : Accum(0);
+        for (int k = 0; k < d; ++k) {
+            Accum& a = out.plane(k)[i];
+            a = replace ? scale * diff[k] : keep * a + weight * scale * diff[k];
+        }
+    }
+}
+
+template<typename Real, typename Accum>
+Accum MeanFieldGravity<Real, Accum>::totalPotential(const VertexStore<Real>& positions, Accum influence) const {
+    return sumPotential(positions, influence);
+}
+
+template<typename Real, typename Accum>
+Accum MeanFieldGravity<Real, Accum>::totalPotential(const ProceduralVertices<Real, Accum>& positions,
+                                                    Accum influence) const {
+    return sumPotential(positions, influence);
+}
+
+template<typename Real, typename Accum>
+template<typename Positions>
+Accum MeanFieldGravity<Real, Accum>::sumPotential(const Positions& positions, Accum influence) const {
+    const std::size_t count = std::min(count_, positions.size());
+    const std::size_t blocks = reductionBlocks(count);
+    std::vector<Accum> partials(blocks);
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t end = std::min(count, (b + 1) * kReductionBlock);
+        CompensatedSum<Accum> sum;
+        for (std::size_t i = b * kReductionBlock; i < end; ++i) {
+            sum.add(potential(positions, i, influence));
+        }
+        partials[b] = sum.value();
+    }
+    return pairwiseSum(std::span<const Accum>(partials));
+}
+
+template class MeanFieldGravity<long double, long double>;
+template class MeanFieldGravity<double, double>;
+template class MeanFieldGravity<float, float>;
+template class MeanFieldGravity<float, double>;
+
+} // namespace UE
@@ -0,0 +1,444 @@
+// ue_trajectory.cpp
+// AMOURANTH RTX Engine, October 2025 - Streaming trajectory files for UniversalEquation.
+// The lock-free chunk handoff, the writer thread and the indexed reader.
+// Dependencies: ue_trajectory.hpp, ue_checkpoint.hpp, C++20 standard library.
+// Supported platforms: Linux, Windows.
+// Zachary Geurts 2025
+
+#include "ue_trajectory.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace UE {
+
+static_assert(std::is_trivially_copyable_v<TrajectoryHeader> && sizeof(TrajectoryHeader) == 56,
+              "TrajectoryHeader layout is part of the format");
+static_assert(std::is_trivially_copyable_v<TrajectoryChunkHeader> && sizeof(TrajectoryChunkHeader) == 56,
+              "TrajectoryChunkHeader layout is part of the format");
+
+namespace {
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Payload size of a chunk; the i32 rounds column is padded so the frame steps stay 8-byte aligned
+std::size_t payloadBytes(std::size_t rows, std::size_t frames, std::size_t frameBytes) noexcept {
+    return rows * sizeof(std::uint64_t) + kTrajectoryColumns.size() * rows * sizeof(double) +
+           alignUp(rows * sizeof(std::int32_t), sizeof(std::uint64_t)) + frames * sizeof(std::uint64_t) +
+           frames * frameBytes;
+}
+
+template<typename T>
+T loadAt(const std::byte* data, std::size_t offset) noexcept {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+std::uint64_t headerChecksum(const TrajectoryHeader& header) noexcept {
+    return checkpointChecksum(&header, offsetof(TrajectoryHeader, headerChecksum));
+}
+
+} // namespace
+
+TrajectoryWriter::TrajectoryWriter(const std::string& path, std::uint64_t vertexCount, int dimensions,
+                                   std::size_t planeStride, std::uint32_t realBytes, const TrajectoryOptions& options)
+    : path_(path),
+      options_(options),
+      header_{},
+      frameBytes_(planeStride * static_cast<std::size_t>(std::max(dimensions, 0)) * realBytes) {
+    if (dimensions < 0 || realBytes == 0 || planeStride < vertexCount || options.stepInterval == 0 ||
+        options.rowsPerChunk == 0) {
+        throw std::invalid_argument("TrajectoryWriter: invalid layout or options");
+    }
+    if (!compressionAvailable(options.compression)) {
+        throw std::invalid_argument("TrajectoryWriter: requested compression is not available in this build");
+    }
+    header_.magic = kTrajectoryMagic;
+    header_.version = kTrajectoryVersion;
+    header_.compression = static_cast<std::uint32_t>(options.compression);
+    header_.realBytes = realBytes;
+    header_.dimensions = dimensions;
+    header_.vertexCount = vertexCount;
+    header_.planeStride = planeStride;
+    header_.stepInterval = options.stepInterval;
+    header_.frameInterval = options.frameInterval;
+    header_.headerChecksum = headerChecksum(header_);
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("TrajectoryWriter: cannot open " + path);
+    }
+    file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    file_.flush();
+    if (!file_) {
+        throw std::runtime_error("TrajectoryWriter: write failed for " + path);
+    }
+    thread_ = std::thread(&TrajectoryWriter::writerLoop, this);
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    // Destructors cannot report errors; call close() to see them
+    try {
+        close();
+    } catch (...) {
+    }
+    auto release = [](Chunk* list) {
+        while (list) {
+            delete std::exchange(list, list->next);
+        }
+    };
+    release(current_);
+    release(spare_);
+    release(recycled_.exchange(nullptr));
+    release(submitted_.exchange(nullptr));
+}
+
+bool TrajectoryWriter::frameDue() const noexcept {
+    return options_.frameInterval > 0 && frameBytes_ > 0 && rowsAppended_ % options_.frameInterval == 0;
+}
+
+void TrajectoryWriter::append(const TrajectoryRow& row, std::span<const std::byte> frame) {
+    rethrowWriterError();
+    if (closed_) {
+        throw std::runtime_error("TrajectoryWriter: append after close");
+    }
+    const bool due = frameDue();
+    if (due && frame.size() != frameBytes_) {
+        throw std::invalid_argument("TrajectoryWriter: frame size does not match the trajectory layout");
+    }
+    if (!current_) {
+        current_ = takeChunk();
+    }
+    current_->rows.push_back(row);
+    if (due) {
+        current_->frameSteps.push_back(row.step);
+        current_->frames.insert(current_->frames.end(), frame.begin(), frame.end());
+    }
+    ++rowsAppended_;
+    // Large frames close a chunk early so that at most about kCheckpointChunk bytes of them sit in memory
+    if (current_->rows.size() >= options_.rowsPerChunk || current_->frames.size() >= kCheckpointChunk) {
+        submit(std::exchange(current_, nullptr));
+    }
+}
+
+void TrajectoryWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    if (current_ && !current_->rows.empty()) {
+        submit(std::exchange(current_, nullptr));
+    }
+    closing_.store(true, std::memory_order_release);
+    submissions_.fetch_add(1, std::memory_order_release);
+    submissions_.notify_one();
+    thread_.join();
+    rethrowWriterError();
+}
+
+TrajectoryWriter::Chunk* TrajectoryWriter::takeChunk() {
+    if (!spare_) {
+        spare_ = recycled_.exchange(nullptr, std::memory_order_acquire);
+    }
+    if (!spare_) {
+        auto* chunk = new Chunk();
+        chunk->rows.reserve(options_.rowsPerChunk);
+        return chunk;
+    }
+    Chunk* chunk = std::exchange(spare_, spare_->next);
+    chunk->rows.clear();
+    chunk->frameSteps.clear();
+    chunk->frames.clear();
+    chunk->next = nullptr;
+    return chunk;
+}
+
+void TrajectoryWriter::submit(Chunk* chunk) {
+    chunk->next = submitted_.load(std::memory_order_relaxed);
+    while (!submitted_.compare_exchange_weak(chunk->next, chunk, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+    }
+    submissions_.fetch_add(1, std::memory_order_release);
+    submissions_.notify_one();
+}
+
+void TrajectoryWriter::writerLoop() {
+    std::vector<std::byte> payload;
+    for (;;) {
+        const std::uint64_t seen = submissions_.load(std::memory_order_acquire);
+        Chunk* batch = submitted_.exchange(nullptr, std::memory_order_acquire);
+        if (!batch) {
+            if (!closing_.load(std::memory_order_acquire)) {
+                submissions_.wait(seen, std::memory_order_acquire);
+                continue;
+            }
+            // close() submits its last chunk before setting closing_, so one more look finds it
+            batch = submitted_.exchange(nullptr, std::memory_order_acquire);
+            if (!batch) {
+                break;
+            }
+        }
+        // The stack holds the newest chunk first
+        Chunk* ordered = nullptr;
+        while (batch) {
+            Chunk* next = batch->next;
+            batch->next = ordered;
+            ordered = batch;
+            batch = next;
+        }
+        while (ordered) {
+            Chunk* chunk = std::exchange(ordered, ordered->next);
+            if (!failed_.load(std::memory_order_relaxed)) {
+                try {
+                    writeChunk(*chunk, payload);
+                } catch (...) {
+                    error_ = std::current_exception();
+                    failed_.store(true, std::memory_order_release);
+                }
+            }
+            chunk->next = recycled_.load(std::memory_order_relaxed);
+            while (!recycled_.compare_exchange_weak(chunk->next, chunk, std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+            }
+        }
+    }
+    if (failed_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    try {
+        const TrajectoryTrailer trailer{static_cast<std::uint64_t>(file_.tellp()), index_.size(),
+                                        kTrajectoryIndexMagic};
+        file_.write(reinterpret_cast<const char*>(index_.data()),
+                    static_cast<std::streamsize>(index_.size() * sizeof(TrajectoryIndexEntry)));
+        file_.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+        file_.close();
+        if (!file_) {
+            throw std::runtime_error("TrajectoryWriter: cannot write the index of " + path_);
+        }
+    } catch (...) {
+        error_ = std::current_exception();
+        failed_.store(true, std::memory_order_release);
+    }
+}
+
+void TrajectoryWriter::writeChunk(const Chunk& chunk, std::vector<std::byte>& payload) {
+    const std::size_t rows = chunk.rows.size();
+    const std::size_t frames = chunk.frameSteps.size();
+    payload.assign(payloadBytes(rows, frames, frameBytes_), std::byte{0});
+    std::byte* out = payload.data();
+    for (const TrajectoryRow& row : chunk.rows) {
+        std::memcpy(out, &row.step, sizeof(row.step));
+        out += sizeof(row.step);
+    }
+    for (double TrajectoryRow::*column : kTrajectoryColumns) {
+        for (const TrajectoryRow& row : chunk.rows) {
+            std::memcpy(out, &(row.*column), sizeof(double));
+            out += sizeof(double);
+        }
+    }
+    for (const TrajectoryRow& row : chunk.rows) {
+        std::memcpy(out, &row.potentialRounds, sizeof(row.potentialRounds));
+        out += sizeof(row.potentialRounds);
+    }
+    out = payload.data() + payloadBytes(rows, 0, 0);
+    std::memcpy(out, chunk.frameSteps.data(), frames * sizeof(std::uint64_t));
+    std::memcpy(out + frames * sizeof(std::uint64_t), chunk.frames.data(), chunk.frames.size());
+
+    std::vector<std::byte> packed;
+    std::span<const std::byte> stored = payload;
+    if (options_.compression != CheckpointCompression::None) {
+        packed = compressChunks(options_.compression, options_.level, payload);
+        stored = packed;
+    }
+    const TrajectoryChunkHeader header{kTrajectoryChunkMagic, chunk.rows.front().step, chunk.rows.back().step,
+                                       static_cast<std::uint32_t>(rows), static_cast<std::uint32_t>(frames),
+                                       stored.size(), payload.size(), checkpointChecksum(stored.data(), stored.size())};
+    const auto offset = static_cast<std::uint64_t>(file_.tellp());
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+    // Flushed per chunk so a crash loses at most the chunks still queued
+    file_.flush();
+    if (!file_) {
+        throw std::runtime_error("TrajectoryWriter: write failed for " + path_);
+    }
+    index_.push_back({header.firstStep, header.lastStep, offset});
+}
+
+void TrajectoryWriter::rethrowWriterError() {
+    if (failed_.load(std::memory_order_acquire)) {
+        std::rethrow_exception(error_);
+    }
+}
+
+TrajectoryReader::TrajectoryReader(const std::string& path) : path_(path) {
+    bytes_ = static_cast<std::size_t>(std::filesystem::file_size(path));
+    if (bytes_ < sizeof(TrajectoryHeader)) {
+        throw std::runtime_error("TrajectoryReader: " + path + " is too small to be a trajectory");
+    }
+    data_ = static_cast<const std::byte*>(MappedPages::mapFile(path, 0, bytes_, false));
+    header_ = loadAt<TrajectoryHeader>(data_, 0);
+    const char* problem = nullptr;
+    if (header_.magic != kTrajectoryMagic) {
+        problem = "not a trajectory";
+    } else if (header_.version != kTrajectoryVersion) {
+        problem = "unsupported trajectory version";
+    } else if (header_.headerChecksum != headerChecksum(header_)) {
+        problem = "header checksum mismatch";
+    } else if (!compressionAvailable(static_cast<CheckpointCompression>(header_.compression))) {
+        problem = "compressed with a codec that is not available in this build";
+    }
+    if (problem) {
+        MappedPages::unmap(const_cast<std::byte*>(data_), bytes_);
+        throw std::runtime_error("TrajectoryReader: " + path + ": " + problem);
+    }
+
+    if (bytes_ >= sizeof(TrajectoryHeader) + sizeof(TrajectoryTrailer)) {
+        const auto trailer = loadAt<TrajectoryTrailer>(data_, bytes_ - sizeof(TrajectoryTrailer));
+        const std::size_t indexBytes = bytes_ - sizeof(TrajectoryTrailer) - sizeof(TrajectoryHeader);
+        indexed_ = trailer.magic == kTrajectoryIndexMagic && trailer.indexOffset >= sizeof(TrajectoryHeader) &&
+                   trailer.chunkCount <= indexBytes / sizeof(TrajectoryIndexEntry) &&
+                   trailer.indexOffset + trailer.chunkCount * sizeof(TrajectoryIndexEntry) ==
+                       bytes_ - sizeof(TrajectoryTrailer);
+        if (indexed_) {
+            index_.resize(trailer.chunkCount);
+            std::memcpy(index_.data(), data_ + trailer.indexOffset, index_.size() * sizeof(TrajectoryIndexEntry));
+        }
+    }
+    if (!indexed_) {
+        // No index: the writer did not close the file. Whole chunks are recovered; a torn last one is dropped.
+        std::size_t offset = sizeof(TrajectoryHeader);
+        while (bytes_ - offset >= sizeof(TrajectoryChunkHeader)) {
+            const auto chunk = loadAt<TrajectoryChunkHeader>(data_, offset);
+            if (chunk.magic != kTrajectoryChunkMagic ||
+                chunk.storedBytes > bytes_ - offset - sizeof(TrajectoryChunkHeader)) {
+                break;
+            }
+            index_.push_back({chunk.firstStep, chunk.lastStep, offset});
+            offset += sizeof(TrajectoryChunkHeader) + static_cast<std::size_t>(chunk.storedBytes);
+        }
+    }
+}
+
+TrajectoryReader::~TrajectoryReader() {
+    MappedPages::unmap(const_cast<std::byte*>(data_), bytes_);
+}
+
+std::size_t TrajectoryReader::frameBytes() const noexcept {
+    return static_cast<std::size_t>(header_.planeStride) * static_cast<std::size_t>(std::max(header_.dimensions, 0)) *
+           header_.realBytes;
+}
+
+const TrajectoryReader::DecodedChunk& TrajectoryReader::chunk(std::size_t i) const {
+    if (i == cachedChunk_) {
+        return cache_;
+    }
+    if (i >= index_.size()) {
+        throw std::out_of_range("TrajectoryReader: chunk index out of range");
+    }
+    cachedChunk_ = static_cast<std::size_t>(-1);
+    const std::size_t offset = index_[i].offset;
+    if (offset > bytes_ || bytes_ - offset < sizeof(TrajectoryChunkHeader)) {
+        throw std::runtime_error("TrajectoryReader: " + path_ + ": chunk outside the file");
+    }
+    const auto header = loadAt<TrajectoryChunkHeader>(data_, offset);
+    const std::size_t rows = header.rows;
+    const std::size_t frames = header.frames;
+    if (header.magic != kTrajectoryChunkMagic ||
+        header.storedBytes > bytes_ - offset - sizeof(TrajectoryChunkHeader) ||
+        header.rawBytes != payloadBytes(rows, frames, frameBytes()) || rows == 0) {
+        throw std::runtime_error("TrajectoryReader: " + path_ + ": corrupt chunk header");
+    }
+    const std::span<const std::byte> stored(data_ + offset + sizeof(TrajectoryChunkHeader),
+                                            static_cast<std::size_t>(header.storedBytes));
+    if (checkpointChecksum(stored.data(), stored.size()) != header.checksum) {
+        throw std::runtime_error("TrajectoryReader: " + path_ + ": checksum mismatch in chunk " + std::to_string(i));
+    }
+    std::vector<std::byte> unpacked;
+    std::span<const std::byte> payload = stored;
+    const auto codec = static_cast<CheckpointCompression>(header_.compression);
+    if (codec != CheckpointCompression::None) {
+        unpacked.resize(static_cast<std::size_t>(header.rawBytes));
+        try {
+            decompressChunks(codec, stored, unpacked);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("TrajectoryReader: " + path_ + ": " + e.what());
+        }
+        payload = unpacked;
+    } else if (header.storedBytes != header.rawBytes) {
+        throw std::runtime_error("TrajectoryReader: " + path_ + ": corrupt chunk header");
+    }
+
+    cache_.rows.assign(rows, TrajectoryRow{});
+    const std::byte* in = payload.data();
+    for (TrajectoryRow& row : cache_.rows) {
+        std::memcpy(&row.step, in, sizeof(row.step));
+        in += sizeof(row.step);
+    }
+    for (double TrajectoryRow::*column : kTrajectoryColumns) {
+        for (TrajectoryRow& row : cache_.rows) {
+            std::memcpy(&(row.*column), in, sizeof(double));
+            in += sizeof(double);
+        }
+    }
+    for (TrajectoryRow& row : cache_.rows) {
+        std::memcpy(&row.potentialRounds, in, sizeof(row.potentialRounds));
+        in += sizeof(row.potentialRounds);
+    }
+    in = payload.data() + payloadBytes(rows, 0, 0);
+    cache_.frameSteps.resize(frames);
+    std::memcpy(cache_.frameSteps.data(), in, frames * sizeof(std::uint64_t));
+    in += frames * sizeof(std::uint64_t);
+    cache_.frames.assign(in, in + frames * frameBytes());
+    cachedChunk_ = i;
+    return cache_;
+}
+
+std::size_t TrajectoryReader::findChunk(std::uint64_t step) const noexcept {
+    auto it = std::upper_bound(index_.begin(), index_.end(), step,
+                               [](std::uint64_t s, const TrajectoryIndexEntry& e) { return s < e.firstStep; });
+    if (it == index_.begin() || std::prev(it)->lastStep < step) {
+        return index_.size();
+    }
+    return static_cast<std::size_t>(std::prev(it) - index_.begin());
+}
+
+std::optional<TrajectoryRow> TrajectoryReader::row(std::uint64_t step) const {
+    const std::size_t c = findChunk(step);
+    if (c == index_.size()) {
+        return std::nullopt;
+    }
+    const auto& rows = chunk(c).rows;
+    auto it = std::lower_bound(rows.begin(), rows.end(), step,
+                               [](const TrajectoryRow& r, std::uint64_t s) { return r.step < s; });
+    if (it == rows.end() || it->step != step) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+bool TrajectoryReader::frame(std::uint64_t step, std::span<std::byte> out) const {
+    if (out.size() != frameBytes()) {
+        throw std::invalid_argument("TrajectoryReader::frame: output size does not match the trajectory layout");
+    }
+    const std::size_t c = findChunk(step);
+    if (c == index_.size()) {
+        return false;
+    }
+    const DecodedChunk& decoded = chunk(c);
+    auto it = std::lower_bound(decoded.frameSteps.begin(), decoded.frameSteps.end(), step);
+    if (it == decoded.frameSteps.end() || *it != step) {
+        return false;
+    }
+    const std::size_t f = static_cast<std::size_t>(it - decoded.frameSteps.begin());
+    std::memcpy(out.data(), decoded.frames.data() + f * out.size(), out.size());
+    return true;
+}
+
+} // namespace UE
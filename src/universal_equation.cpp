@@ -12,83 +12,72 @@
 #include <fstream>
 #include <memory>
 #include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <exception>
+#include <future>
+#include <utility>
 #include <latch>
 #include <omp.h>
 #include <source_location>
 
-UniversalEquation::UniversalEquation(
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(
+    DeferInitialization,
+    const UE::Params<Accum>& params,
     int maxDimensions,
     int mode,
-    long double influence,
-    long double weak,
-    long double collapse,
-    long double twoD,
-    long double threeDInfluence,
-    long double oneDPermeation,
-    long double nurbMatterStrength,
-    long double nurbEnergyStrength,
-    long double alpha,
-    long double beta,
-    long double carrollFactor,
-    long double meanFieldApprox,
-    long double asymCollapse,
-    long double perspectiveTrans,
-    long double perspectiveFocal,
-    long double spinInteraction,
-    long double emFieldStrength,
-    long double renormFactor,
-    long double vacuumEnergy,
-    long double godWaveFreq,
     bool debug,
-    uint64_t numVertices
-) : influence_(std::clamp(influence, 0.0L, 10.0L)),
-    weak_(std::clamp(weak, 0.0L, 1.0L)),
-    collapse_(std::clamp(collapse, 0.0L, 5.0L)),
-    twoD_(std::clamp(twoD, 0.0L, 5.0L)),
-    threeDInfluence_(std::clamp(threeDInfluence, 0.0L, 5.0L)),
-    oneDPermeation_(std::clamp(oneDPermeation, 0.0L, 5.0L)),
-    nurbMatterStrength_(std::clamp(nurbMatterStrength, 0.0L, 1.0L)),
-    nurbEnergyStrength_(std::clamp(nurbEnergyStrength, 0.0L, 2.0L)),
-    alpha_(std::clamp(alpha, 0.01L, 10.0L)),
-    beta_(std::clamp(beta, 0.0L, 1.0L)),
-    carrollFactor_(std::clamp(carrollFactor, 0.0L, 1.0L)),
-    meanFieldApprox_(std::clamp(meanFieldApprox, 0.0L, 1.0L)),
-    asymCollapse_(std::clamp(asymCollapse, 0.0L, 1.0L)),
-    perspectiveTrans_(std::clamp(perspectiveTrans, 0.0L, 10.0L)),
-    perspectiveFocal_(std::clamp(perspectiveFocal, 1.0L, 20.0L)),
-    spinInteraction_(std::clamp(spinInteraction, 0.0L, 1.0L)),
-    emFieldStrength_(std::clamp(emFieldStrength, 0.0L, 1.0e7L)),
-    renormFactor_(std::clamp(renormFactor, 0.1L, 10.0L)),
-    vacuumEnergy_(std::clamp(vacuumEnergy, 0.0L, 1.0L)),
-    godWaveFreq_(std::clamp(godWaveFreq, 0.1L, 10.0L)),
+    uint64_t numVertices,
+    const UE::VertexStorage& storage
+) : params_(std::make_shared<const UE::Params<Accum>>(params)),
+    pendingParams_(*params_.load()),
+    updateDepth_(0),
+    pendingDirty_(kDirtyNone),
     currentDimension_(std::clamp(mode <= 0 ? 1 : mode, 1, maxDimensions <= 0 ? 19 : maxDimensions)),
     mode_(std::clamp(mode <= 0 ? 1 : mode, 1, maxDimensions <= 0 ? 19 : maxDimensions)),
     debug_(debug),
     needsUpdate_(true),
-    totalCharge_(0.0L),
-    avgProjScale_(1.0L),
+    dirty_(kDirtyStructure),
+    totalCharge_(Accum(0)),
+    avgProjScale_(Accum(1)),
     simulationTime_(0.0f),
-    materialDensity_(1000.0L), // Default to water density
     currentVertices_(0),
-    maxVertices_(std::max<uint64_t>(1ULL, std::min(numVertices, static_cast<uint64_t>(1ULL << 20)))),
+    vertexStorage_(storage),
+    maxVertices_(checkedVertexCount(numVertices, storage)),
     maxDimensions_(std::max(1, std::min(maxDimensions <= 0 ? 19 : maxDimensions, 19))),
-    omega_(maxDimensions_ > 0 ? 2.0L * std::numbers::pi_v<long double> / (2 * maxDimensions_ - 1) : 1.0L),
-    invMaxDim_(maxDimensions_ > 0 ? 1.0L / maxDimensions_ : 1e-15L),
+    omega_(maxDimensions_ > 0 ? Accum(2) * std::numbers::pi_v<Accum> / (2 * maxDimensions_ - 1) : Accum(1)),
+    invMaxDim_(maxDimensions_ > 0 ? Accum(1) / maxDimensions_ : Accum(1e-15L)),
     nCubeVertices_(),
     vertexMomenta_(),
     vertexSpins_(),
     vertexWaveAmplitudes_(),
     interactions_(),
     projectedVerts_(),
-    cachedCos_(maxDimensions_ + 1, 0.0L),
-    nurbMatterControlPoints_(5, 1.0L),
-    nurbEnergyControlPoints_(5, 1.0L),
-    nurbKnots_(9, 0.0L),
-    nurbWeights_(5, 1.0L),
+    cachedCos_(maxDimensions_ + 1, Accum(0)),
+    nurbMatterControlPoints_(5, Accum(1)),
+    nurbEnergyControlPoints_(5, Accum(1)),
+    nurbKnots_(9, Accum(0)),
+    nurbWeights_(5, Accum(1)),
     dimensionData_(std::vector<UE::DimensionData>(std::max(1, std::min(maxDimensions, 19)), UE::DimensionData{
         0, 1.0L, glm::vec3(0.0f, 0.0f, 0.0f), 1.0f, 1.0L, 0.032774L, 1.0L, 1.0L, 0.0L, 0.0L, 0.0L, 0.0L})),
-    navigator_(nullptr) {
+    navigator_(nullptr),
+    barnesHut_(),
+    pairwiseGravity_(),
+    meanField_(),
+    particleMesh_(),
+    accelerations_(),
+    energyScratch_(),
+    vertexDirty_(),
+    dirtyVertices_(),
+    centroidSum_(),
+    centroid_(),
+    driftPartials_(kCentroidBlocks * maxDimensions_, Accum(0)),
+    reductionPartials_(),
+    energySums_{},
+    energySumsStale_(true),
+    trajectory_(),
+    trajectoryStep_(0) {
     LOG_INFO_CAT("Simulation", "Constructing UniversalEquation: maxVertices={}, maxDimensions={}, mode={}, godWaveFreq={}",
                  std::source_location::current(), getMaxVertices(), getMaxDimensions(), getMode(), getGodWaveFreq());
     if (getMaxVertices() > 1'000'000) {
@@ -100,6 +89,78 @@ UniversalEquation::UniversalEquation(
                       std::source_location::current(), maxDimensions, mode);
         throw std::invalid_argument("maxDimensions and mode must be greater than 0");
     }
+    nurbMatterControlPoints_ = {Accum(1), Accum(0.8L), Accum(0.5L), Accum(0.3L), Accum(0.1L)};
+    nurbEnergyControlPoints_ = {Accum(0.1L), Accum(0.5L), Accum(1), Accum(1.5L), Accum(2)};
+    nurbKnots_ = {Accum(0), Accum(0), Accum(0), Accum(0), Accum(0.5L), Accum(1), Accum(1), Accum(1), Accum(1)};
+    nurbWeights_ = {Accum(1), Accum(1), Accum(1), Accum(1), Accum(1)};
+    if (vertexStorage_.mapped()) {
+        LOG_INFO_CAT("Simulation", "Mapping vertex planes from files in '{}', resident window {} bytes per store",
+                     std::source_location::current(), vertexStorage_.directory, vertexStorage_.residentBytes);
+        nCubeVertices_.setStorage(vertexStorage_);
+        vertexMomenta_.setStorage(vertexStorage_);
+        interactions_.setStorage(vertexStorage_);
+        accelerations_.setStorage(vertexStorage_);
+    }
+}
+
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(
+    int maxDimensions,
+    int mode,
+    Accum influence,
+    Accum weak,
+    Accum collapse,
+    Accum twoD,
+    Accum threeDInfluence,
+    Accum oneDPermeation,
+    Accum nurbMatterStrength,
+    Accum nurbEnergyStrength,
+    Accum alpha,
+    Accum beta,
+    Accum carrollFactor,
+    Accum meanFieldApprox,
+    Accum asymCollapse,
+    Accum perspectiveTrans,
+    Accum perspectiveFocal,
+    Accum spinInteraction,
+    Accum emFieldStrength,
+    Accum renormFactor,
+    Accum vacuumEnergy,
+    Accum godWaveFreq,
+    bool debug,
+    uint64_t numVertices,
+    const UE::VertexStorage& storage
+) : UniversalEquationT(DeferInitialization{}, UE::Params<Accum>{
+        .influence = std::clamp(influence, Accum(0), Accum(10)),
+        .weak = std::clamp(weak, Accum(0), Accum(1)),
+        .collapse = std::clamp(collapse, Accum(0), Accum(5)),
+        .twoD = std::clamp(twoD, Accum(0), Accum(5)),
+        .threeDInfluence = std::clamp(threeDInfluence, Accum(0), Accum(5)),
+        .oneDPermeation = std::clamp(oneDPermeation, Accum(0), Accum(5)),
+        .nurbMatterStrength = std::clamp(nurbMatterStrength, Accum(0), Accum(1)),
+        .nurbEnergyStrength = std::clamp(nurbEnergyStrength, Accum(0), Accum(2)),
+        .alpha = std::clamp(alpha, Accum(0.01L), Accum(10)),
+        .beta = std::clamp(beta, Accum(0), Accum(1)),
+        .carrollFactor = std::clamp(carrollFactor, Accum(0), Accum(1)),
+        .meanFieldApprox = std::clamp(meanFieldApprox, Accum(0), Accum(1)),
+        .asymCollapse = std::clamp(asymCollapse, Accum(0), Accum(1)),
+        .perspectiveTrans = std::clamp(perspectiveTrans, Accum(0), Accum(10)),
+        .perspectiveFocal = std::clamp(perspectiveFocal, Accum(1), Accum(20)),
+        .spinInteraction = std::clamp(spinInteraction, Accum(0), Accum(1)),
+        .emFieldStrength = std::clamp(emFieldStrength, Accum(0), Accum(1.0e7L)),
+        .renormFactor = std::clamp(renormFactor, Accum(0.1L), Accum(10)),
+        .vacuumEnergy = std::clamp(vacuumEnergy, Accum(0), Accum(1)),
+        .godWaveFreq = std::clamp(godWaveFreq, Accum(0.1L), Accum(10)),
+        .materialDensity = Accum(1000), // Default to water density
+        .openingAngle = Accum(0.5L),
+        .meshGridSize = 32,
+        .gravitySolver = UE::GravitySolver::Exact,
+        .integrator = UE::Integrator::Euler,
+        .potentialTargetError = Accum(1.0e-3L),
+        .potentialStrata = 64,
+        .potentialMaxRounds = 8,
+        .potentialSeed = 0x5851f42d4c957f2dULL},
+        maxDimensions, mode, debug, numVertices, storage) {
     if (debug_.load() && (influence != getInfluence() || weak != getWeak() || collapse != getCollapse() ||
                           twoD != getTwoD() || threeDInfluence != getThreeDInfluence() ||
                           oneDPermeation != getOneDPermeation() || nurbMatterStrength != getNurbMatterStrength() ||
@@ -113,10 +174,6 @@ UniversalEquation::UniversalEquation(
         LOG_WARNING_CAT("Simulation", "Some input parameters were clamped to valid ranges",
                         std::source_location::current());
     }
-    nurbMatterControlPoints_ = {1.0L, 0.8L, 0.5L, 0.3L, 0.1L};
-    nurbEnergyControlPoints_ = {0.1L, 0.5L, 1.0L, 1.5L, 2.0L};
-    nurbKnots_ = {0.0L, 0.0L, 0.0L, 0.0L, 0.5L, 1.0L, 1.0L, 1.0L, 1.0L};
-    nurbWeights_ = {1.0L, 1.0L, 1.0L, 1.0L, 1.0L};
     try {
         initializeWithRetry();
         LOG_INFO_CAT("Simulation", "UniversalEquation initialized: vertices={}, totalCharge={}",
@@ -127,56 +184,45 @@ UniversalEquation::UniversalEquation(
     }
 }
 
-UniversalEquation::UniversalEquation(
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(
     int maxDimensions,
     int mode,
-    long double influence,
-    long double weak,
+    Accum influence,
+    Accum weak,
     bool debug,
-    uint64_t numVertices
-) : UniversalEquation(
-        maxDimensions, mode, influence, weak, 5.0L, 1.5L, 5.0L, 1.0L, 0.5L, 1.0L, 0.01L, 0.5L, 0.1L,
-        0.5L, 0.5L, 2.0L, 4.0L, 1.0L, 1.0e6L, 1.0L, 0.5L, 2.0L, debug, numVertices) {
+    uint64_t numVertices,
+    const UE::VertexStorage& storage
+) : UniversalEquationT(
+        maxDimensions, mode, influence, weak, Accum(5), Accum(1.5L), Accum(5), Accum(1), Accum(0.5L), Accum(1), Accum(0.01L), Accum(0.5L), Accum(0.1L),
+        Accum(0), Accum(0.5L), Accum(2), Accum(4), Accum(1), Accum(1.0e6L), Accum(1), Accum(0.5L), Accum(2), debug, numVertices,
+        storage) {
     LOG_DEBUG_CAT("Simulation", "Initialized UniversalEquation with simplified constructor, godWaveFreq={}",
                   std::source_location::current(), getGodWaveFreq());
 }
 
-UniversalEquation::UniversalEquation(const UniversalEquation& other)
-    : influence_(other.influence_.load()),
-      weak_(other.weak_.load()),
-      collapse_(other.collapse_.load()),
-      twoD_(other.twoD_.load()),
-      threeDInfluence_(other.threeDInfluence_.load()),
-      oneDPermeation_(other.oneDPermeation_.load()),
-      nurbMatterStrength_(other.nurbMatterStrength_.load()),
-      nurbEnergyStrength_(other.nurbEnergyStrength_.load()),
-      alpha_(other.alpha_.load()),
-      beta_(other.beta_.load()),
-      carrollFactor_(other.carrollFactor_.load()),
-      meanFieldApprox_(other.meanFieldApprox_.load()),
-      asymCollapse_(other.asymCollapse_.load()),
-      perspectiveTrans_(other.perspectiveTrans_.load()),
-      perspectiveFocal_(other.perspectiveFocal_.load()),
-      spinInteraction_(other.spinInteraction_.load()),
-      emFieldStrength_(other.emFieldStrength_.load()),
-      renormFactor_(other.renormFactor_.load()),
-      vacuumEnergy_(other.vacuumEnergy_.load()),
-      godWaveFreq_(other.godWaveFreq_.load()),
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(const UniversalEquationT& other)
+    : params_(other.params_.load()),
+      pendingParams_(*params_.load()),
+      updateDepth_(0),
+      pendingDirty_(kDirtyNone),
       currentDimension_(other.currentDimension_.load()),
       mode_(other.mode_.load()),
       debug_(other.debug_.load()),
       needsUpdate_(other.needsUpdate_.load()),
+      dirty_(kDirtyStructure),
       totalCharge_(other.totalCharge_.load()),
       avgProjScale_(other.avgProjScale_.load()),
       simulationTime_(other.simulationTime_.load()),
-      materialDensity_(other.materialDensity_.load()),
       currentVertices_(other.currentVertices_.load()),
+      vertexStorage_(other.vertexStorage_),
       maxVertices_(other.maxVertices_),
       maxDimensions_(other.maxDimensions_),
       omega_(other.omega_),
       invMaxDim_(other.invMaxDim_),
-      nCubeVertices_(),
-      vertexMomenta_(),
+      nCubeVertices_(other.nCubeVertices_),
+      vertexMomenta_(other.vertexMomenta_),
       vertexSpins_(other.vertexSpins_),
       vertexWaveAmplitudes_(other.vertexWaveAmplitudes_),
       interactions_(other.interactions_),
@@ -187,18 +233,27 @@ UniversalEquation::UniversalEquation(const UniversalEquation& other)
       nurbKnots_(other.nurbKnots_),
       nurbWeights_(other.nurbWeights_),
       dimensionData_(other.dimensionData_),
-      navigator_(nullptr) {
+      navigator_(nullptr),
+      barnesHut_(),
+      pairwiseGravity_(),
+      meanField_(),
+      particleMesh_(),
+      accelerations_(),
+      energyScratch_(),
+      vertexDirty_(),
+      dirtyVertices_(),
+      centroidSum_(),
+      centroid_(),
+      driftPartials_(kCentroidBlocks * maxDimensions_, Accum(0)),
+      reductionPartials_(),
+      energySums_{},
+      energySumsStale_(true),
+      trajectory_(),
+      trajectoryStep_(0) {
     LOG_INFO_CAT("Simulation", "Copy constructing UniversalEquation: vertices={}",
                  std::source_location::current(), other.nCubeVertices_.size());
+    accelerations_.setStorage(vertexStorage_);
     try {
-        nCubeVertices_.reserve(other.nCubeVertices_.size());
-        vertexMomenta_.reserve(other.nCubeVertices_.size());
-        for (const auto& vertex : other.nCubeVertices_) {
-            nCubeVertices_.emplace_back(vertex);
-        }
-        for (const auto& momentum : other.vertexMomenta_) {
-            vertexMomenta_.emplace_back(momentum);
-        }
         initializeWithRetry();
         validateProjectedVertices();
         LOG_DEBUG_CAT("Simulation", "Copy constructor completed: vertices={}",
@@ -209,41 +264,28 @@ UniversalEquation::UniversalEquation(const UniversalEquation& other)
     }
 }
 
-UniversalEquation& UniversalEquation::operator=(const UniversalEquation& other) {
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>& UniversalEquationT<Real, Accum>::operator=(const UniversalEquationT& other) {
     if (this != &other) {
         LOG_INFO_CAT("Simulation", "Assigning UniversalEquation: vertices={}",
                      std::source_location::current(), other.nCubeVertices_.size());
-        influence_.store(other.influence_.load());
-        weak_.store(other.weak_.load());
-        collapse_.store(other.collapse_.load());
-        twoD_.store(other.twoD_.load());
-        threeDInfluence_.store(other.threeDInfluence_.load());
-        oneDPermeation_.store(other.oneDPermeation_.load());
-        nurbMatterStrength_.store(other.nurbMatterStrength_.load());
-        nurbEnergyStrength_.store(other.nurbEnergyStrength_.load());
-        alpha_.store(other.alpha_.load());
-        beta_.store(other.beta_.load());
-        carrollFactor_.store(other.carrollFactor_.load());
-        meanFieldApprox_.store(other.meanFieldApprox_.load());
-        asymCollapse_.store(other.asymCollapse_.load());
-        perspectiveTrans_.store(other.perspectiveTrans_.load());
-        perspectiveFocal_.store(other.perspectiveFocal_.load());
-        spinInteraction_.store(other.spinInteraction_.load());
-        emFieldStrength_.store(other.emFieldStrength_.load());
-        renormFactor_.store(other.renormFactor_.load());
-        vacuumEnergy_.store(other.vacuumEnergy_.load());
-        godWaveFreq_.store(other.godWaveFreq_.load());
+        {
+            std::lock_guard<std::mutex> lock(paramsMutex_);
+            params_.store(other.params_.load(), std::memory_order_release);
+            pendingParams_ = *params_.load();
+        }
         currentDimension_.store(other.currentDimension_.load());
         mode_.store(other.mode_.load());
         debug_.store(other.debug_.load());
         needsUpdate_.store(other.needsUpdate_.load());
+        dirty_.store(kDirtyStructure);
+        energySumsStale_.store(true);
         totalCharge_.store(other.totalCharge_.load());
         avgProjScale_.store(other.avgProjScale_.load());
         simulationTime_.store(other.simulationTime_.load());
-        materialDensity_.store(other.materialDensity_.load());
         currentVertices_.store(other.currentVertices_.load());
-        nCubeVertices_.clear();
-        vertexMomenta_.clear();
+        nCubeVertices_ = other.nCubeVertices_;
+        vertexMomenta_ = other.vertexMomenta_;
         vertexSpins_ = other.vertexSpins_;
         vertexWaveAmplitudes_ = other.vertexWaveAmplitudes_;
         interactions_ = other.interactions_;
@@ -256,14 +298,6 @@ UniversalEquation& UniversalEquation::operator=(const UniversalEquation& other)
         dimensionData_ = other.dimensionData_;
         navigator_ = nullptr;
         try {
-            nCubeVertices_.reserve(other.nCubeVertices_.size());
-            vertexMomenta_.reserve(other.nCubeVertices_.size());
-            for (const auto& vertex : other.nCubeVertices_) {
-                nCubeVertices_.emplace_back(vertex);
-            }
-            for (const auto& momentum : other.vertexMomenta_) {
-                vertexMomenta_.emplace_back(momentum);
-            }
             initializeWithRetry();
             validateProjectedVertices();
             LOG_DEBUG_CAT("Simulation", "Copy assignment completed: vertices={}",
@@ -276,12 +310,227 @@ UniversalEquation& UniversalEquation::operator=(const UniversalEquation& other)
     return *this;
 }
 
-UniversalEquation::~UniversalEquation() {
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(ForkState, const UniversalEquationT& other)
+    : params_(other.params_.load()),
+      pendingParams_(*params_.load()),
+      updateDepth_(0),
+      pendingDirty_(kDirtyNone),
+      currentDimension_(other.currentDimension_.load()),
+      mode_(other.mode_.load()),
+      debug_(other.debug_.load()),
+      needsUpdate_(other.needsUpdate_.load()),
+      dirty_(other.dirty_.load()),
+      totalCharge_(other.totalCharge_.load()),
+      avgProjScale_(other.avgProjScale_.load()),
+      simulationTime_(other.simulationTime_.load()),
+      currentVertices_(other.currentVertices_.load()),
+      vertexStorage_(other.vertexStorage_),
+      maxVertices_(other.maxVertices_),
+      maxDimensions_(other.maxDimensions_),
+      omega_(other.omega_),
+      invMaxDim_(other.invMaxDim_),
+      nCubeVertices_(other.nCubeVertices_),
+      vertexMomenta_(other.vertexMomenta_),
+      vertexSpins_(other.vertexSpins_),
+      vertexWaveAmplitudes_(other.vertexWaveAmplitudes_),
+      interactions_(other.interactions_),
+      projectedVerts_(other.projectedVerts_),
+      cachedCos_(other.cachedCos_),
+      nurbMatterControlPoints_(other.nurbMatterControlPoints_),
+      nurbEnergyControlPoints_(other.nurbEnergyControlPoints_),
+      nurbKnots_(other.nurbKnots_),
+      nurbWeights_(other.nurbWeights_),
+      dimensionData_(other.dimensionData_),
+      navigator_(nullptr),
+      barnesHut_(),
+      pairwiseGravity_(),
+      meanField_(),
+      particleMesh_(),
+      accelerations_(other.accelerations_),
+      energyScratch_(),
+      vertexDirty_(other.vertexDirty_),
+      dirtyVertices_(other.dirtyVertices_),
+      centroidSum_(other.centroidSum_),
+      centroid_(other.centroid_),
+      driftPartials_(kCentroidBlocks * maxDimensions_, Accum(0)),
+      reductionPartials_(),
+      energySums_(other.energySums_),
+      energySumsStale_(other.energySumsStale_.load()),
+      trajectory_(),
+      trajectoryStep_(0) {
+    // Per-vertex potential statistics belong to the last compute(), which the fork reports as well
+    energyScratch_.vertexMean = other.energyScratch_.vertexMean;
+    energyScratch_.vertexM2 = other.energyScratch_.vertexM2;
+}
+
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum> UniversalEquationT<Real, Accum>::fork() const {
+    LOG_INFO_CAT("Simulation", "Forking UniversalEquation: vertices={}, simulationTime={}",
+                 std::source_location::current(), nCubeVertices_.size(), getSimulationTime());
+    return UniversalEquationT(ForkState{}, *this);
+}
+
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::UniversalEquationT(UniversalEquationT&& other) noexcept
+    : params_(other.params_.load()),
+      pendingParams_(other.pendingParams_),
+      updateDepth_(other.updateDepth_),
+      pendingDirty_(other.pendingDirty_),
+      currentDimension_(other.currentDimension_.load()),
+      mode_(other.mode_.load()),
+      debug_(other.debug_.load()),
+      needsUpdate_(other.needsUpdate_.load()),
+      dirty_(other.dirty_.load()),
+      totalCharge_(other.totalCharge_.load()),
+      avgProjScale_(other.avgProjScale_.load()),
+      simulationTime_(other.simulationTime_.load()),
+      currentVertices_(other.currentVertices_.load()),
+      vertexStorage_(std::move(other.vertexStorage_)),
+      maxVertices_(other.maxVertices_),
+      maxDimensions_(other.maxDimensions_),
+      omega_(other.omega_),
+      invMaxDim_(other.invMaxDim_),
+      nCubeVertices_(std::move(other.nCubeVertices_)),
+      vertexMomenta_(std::move(other.vertexMomenta_)),
+      vertexSpins_(std::move(other.vertexSpins_)),
+      vertexWaveAmplitudes_(std::move(other.vertexWaveAmplitudes_)),
+      interactions_(std::move(other.interactions_)),
+      projectedVerts_(std::move(other.projectedVerts_)),
+      cachedCos_(std::move(other.cachedCos_)),
+      nurbMatterControlPoints_(std::move(other.nurbMatterControlPoints_)),
+      nurbEnergyControlPoints_(std::move(other.nurbEnergyControlPoints_)),
+      nurbKnots_(std::move(other.nurbKnots_)),
+      nurbWeights_(std::move(other.nurbWeights_)),
+      dimensionData_(std::move(other.dimensionData_)),
+      navigator_(std::exchange(other.navigator_, nullptr)),
+      barnesHut_(std::move(other.barnesHut_)),
+      pairwiseGravity_(std::move(other.pairwiseGravity_)),
+      meanField_(std::move(other.meanField_)),
+      particleMesh_(std::move(other.particleMesh_)),
+      accelerations_(std::move(other.accelerations_)),
+      energyScratch_(std::move(other.energyScratch_)),
+      vertexDirty_(std::move(other.vertexDirty_)),
+      dirtyVertices_(std::move(other.dirtyVertices_)),
+      centroidSum_(std::move(other.centroidSum_)),
+      centroid_(std::move(other.centroid_)),
+      driftPartials_(std::move(other.driftPartials_)),
+      reductionPartials_(std::move(other.reductionPartials_)),
+      energySums_(other.energySums_),
+      energySumsStale_(other.energySumsStale_.load()),
+      trajectory_(std::move(other.trajectory_)),
+      trajectoryStep_(other.trajectoryStep_) {}
+
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>& UniversalEquationT<Real, Accum>::operator=(UniversalEquationT&& other) noexcept {
+    if (this != &other) {
+        // The previous state is released here rather than left in other
+        UniversalEquationT moved(std::move(other));
+        swap(moved);
+    }
+    return *this;
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::swap(UniversalEquationT& other) noexcept {
+    if (this == &other) {
+        return;
+    }
+    const auto exchange = [](auto& a, auto& b) {
+        const auto value = a.load();
+        a.store(b.load());
+        b.store(value);
+    };
+    // The mutexes stay with their instances; neither may be in use during the swap
+    exchange(params_, other.params_);
+    std::swap(pendingParams_, other.pendingParams_);
+    std::swap(updateDepth_, other.updateDepth_);
+    std::swap(pendingDirty_, other.pendingDirty_);
+    exchange(currentDimension_, other.currentDimension_);
+    exchange(mode_, other.mode_);
+    exchange(debug_, other.debug_);
+    exchange(needsUpdate_, other.needsUpdate_);
+    exchange(dirty_, other.dirty_);
+    exchange(totalCharge_, other.totalCharge_);
+    exchange(avgProjScale_, other.avgProjScale_);
+    exchange(simulationTime_, other.simulationTime_);
+    exchange(currentVertices_, other.currentVertices_);
+    std::swap(vertexStorage_, other.vertexStorage_);
+    std::swap(maxVertices_, other.maxVertices_);
+    std::swap(maxDimensions_, other.maxDimensions_);
+    std::swap(omega_, other.omega_);
+    std::swap(invMaxDim_, other.invMaxDim_);
+    nCubeVertices_.swap(other.nCubeVertices_);
+    vertexMomenta_.swap(other.vertexMomenta_);
+    std::swap(vertexSpins_, other.vertexSpins_);
+    std::swap(vertexWaveAmplitudes_, other.vertexWaveAmplitudes_);
+    std::swap(interactions_, other.interactions_);
+    std::swap(projectedVerts_, other.projectedVerts_);
+    std::swap(cachedCos_, other.cachedCos_);
+    std::swap(nurbMatterControlPoints_, other.nurbMatterControlPoints_);
+    std::swap(nurbEnergyControlPoints_, other.nurbEnergyControlPoints_);
+    std::swap(nurbKnots_, other.nurbKnots_);
+    std::swap(nurbWeights_, other.nurbWeights_);
+    std::swap(dimensionData_, other.dimensionData_);
+    std::swap(navigator_, other.navigator_);
+    std::swap(barnesHut_, other.barnesHut_);
+    std::swap(pairwiseGravity_, other.pairwiseGravity_);
+    std::swap(meanField_, other.meanField_);
+    std::swap(particleMesh_, other.particleMesh_);
+    accelerations_.swap(other.accelerations_);
+    std::swap(energyScratch_, other.energyScratch_);
+    std::swap(vertexDirty_, other.vertexDirty_);
+    std::swap(dirtyVertices_, other.dirtyVertices_);
+    std::swap(centroidSum_, other.centroidSum_);
+    std::swap(centroid_, other.centroid_);
+    std::swap(driftPartials_, other.driftPartials_);
+    std::swap(reductionPartials_, other.reductionPartials_);
+    std::swap(energySums_, other.energySums_);
+    exchange(energySumsStale_, other.energySumsStale_);
+    std::swap(trajectory_, other.trajectory_);
+    std::swap(trajectoryStep_, other.trajectoryStep_);
+}
+
+template<typename Real, typename Accum>
+UniversalEquationT<Real, Accum>::~UniversalEquationT() {
     LOG_DEBUG_CAT("Simulation", "Destroying UniversalEquation: vertices={}",
                   std::source_location::current(), nCubeVertices_.size());
 }
 
-void UniversalEquation::initializeNCube() {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::initialVertexState(UE::VertexStore<Real>& positions, UE::VertexStore<Real>& momenta) {
+    const uint64_t count = positions.size();
+    const int d = std::min(positions.dimensions(), momenta.dimensions());
+    // Same static schedule as the compute loops, so each thread first-touches the pages it later works on. Mapped
+    // planes are written one resident window at a time; heap planes in a single window.
+    UE::streamResident(count, UE::kReductionBlock, [&](uint64_t begin, uint64_t end) {
+        #pragma omp parallel
+        for (int j = 0; j < d; ++j) {
+            auto coords = positions.plane(j);
+            auto p = momenta.plane(j);
+            #pragma omp for schedule(static) nowait
+            for (uint64_t i = begin; i < end; ++i) {
+                coords[i] = UE::ProceduralVertices<Real, Accum>::latticeCoordinate(i, count);
+                p[i] = UE::ProceduralVertices<Real, Accum>::latticeMomentum(i);
+            }
+        }
+    }, positions, momenta);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::initialScalars(std::vector<Real>& spins, std::vector<Real>& amplitudes,
+                                                     uint64_t count, Accum oneDPermeation) {
+    spins.resize(count);
+    amplitudes.resize(count);
+    #pragma omp parallel for schedule(static)
+    for (uint64_t i = 0; i < count; ++i) {
+        spins[i] = UE::ProceduralVertices<Real, Accum>::latticeSpin(i);
+        amplitudes[i] = UE::ProceduralVertices<Real, Accum>::latticeAmplitude(i, count, oneDPermeation);
+    }
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::initializeNCube() {
     std::latch init_latch(1);
     try {
         LOG_INFO_CAT("Simulation", "Initializing n-cube: maxVertices={}, currentDimension={}",
@@ -291,51 +540,39 @@ void UniversalEquation::initializeNCube() {
                             std::source_location::current(), getMaxVertices());
         }
 
-        nCubeVertices_.clear();
-        vertexMomenta_.clear();
+        const uint64_t count = getMaxVertices();
         vertexSpins_.clear();
         vertexWaveAmplitudes_.clear();
-        interactions_.clear();
         projectedVerts_.clear();
-        LOG_DEBUG_CAT("Simulation", "Cleared all vectors", std::source_location::current());
-
-        LOG_DEBUG_CAT("Simulation", "Reserving {} elements for nCubeVertices_",
-                      std::source_location::current(), getMaxVertices());
-        nCubeVertices_.reserve(getMaxVertices());
-        if (nCubeVertices_.capacity() < getMaxVertices()) {
-            LOG_ERROR_CAT("Simulation", "Failed to reserve {} elements for nCubeVertices_, actual capacity={}",
-                          std::source_location::current(), getMaxVertices(), nCubeVertices_.capacity());
-            throw std::bad_alloc();
-        }
-        vertexMomenta_.reserve(getMaxVertices());
-        vertexSpins_.reserve(getMaxVertices());
-        vertexWaveAmplitudes_.reserve(getMaxVertices());
-        interactions_.reserve(getMaxVertices());
-        projectedVerts_.reserve(getMaxVertices());
-        setTotalCharge(0.0L);
-
-        for (uint64_t i = 0; i < getMaxVertices(); ++i) {
-            std::vector<long double> vertex(getCurrentDimension(), 0.0L);
-            std::vector<long double> momentum(getCurrentDimension(), 0.0L);
-            for (int j = 0; j < getCurrentDimension(); ++j) {
-                vertex[j] = (static_cast<long double>(i) / getMaxVertices()) * 0.0254L; // Scale to 1-inch cube
-                momentum[j] = (static_cast<long double>(i % 2) - 0.5L) * 0.01L;
-            }
-            long double spin = (i % 2 == 0 ? 0.032774L : -0.032774L);
-            long double amplitude = getOneDPermeation() * (1.0L + 0.1L * (i / static_cast<long double>(getMaxVertices())));
-            nCubeVertices_.push_back(std::move(vertex));
-            vertexMomenta_.push_back(std::move(momentum));
-            vertexSpins_.push_back(spin);
-            vertexWaveAmplitudes_.push_back(amplitude);
-            interactions_.push_back(UE::DimensionInteraction(
-                static_cast<int>(i), 0.0L, 0.0L, std::vector<long double>(std::min(3, getCurrentDimension()), 0.0L), 0.0L));
-            projectedVerts_.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            totalCharge_.fetch_add(1.0L / getMaxVertices());
-            if (getDebug() && (i % 1000 == 0 || i == getMaxVertices() - 1)) {
-                LOG_DEBUG_CAT("Simulation", "Initialized vertex {}/{}, nCubeVertices_.size()={}",
-                              std::source_location::current(), i, getMaxVertices(), nCubeVertices_.size());
+        markDirty(kDirtyStructure);
+
+        // Stores copied from another instance carry its backing; this instance's takes precedence
+        for (UE::VertexStore<Real>* store : {&nCubeVertices_, &vertexMomenta_}) {
+            if (!(store->storage() == vertexStorage_)) {
+                store->clear();
+                store->setStorage(vertexStorage_);
             }
         }
+        interactions_.setStorage(vertexStorage_);
+
+        // Planes are reallocated without zero-filling; initialVertexState() writes every element in parallel
+        LOG_DEBUG_CAT("Simulation", "Allocating {} x {} coordinate planes for nCubeVertices_",
+                      std::source_location::current(), getCurrentDimension(), count);
+        nCubeVertices_.reallocate(count, getCurrentDimension());
+        vertexMomenta_.reallocate(count, getCurrentDimension());
+        // Interaction columns are kept across re-initialization; updateInteractions() fills them
+        interactions_.resize(count);
+        interactions_.setVectorPotentialDims(std::min(3, getCurrentDimension()));
+
+        initialVertexState(nCubeVertices_, vertexMomenta_);
+        initialScalars(vertexSpins_.mutate(), vertexWaveAmplitudes_.mutate(), count, getOneDPermeation());
+        projectedVerts_.resize(count, glm::vec3(0.0f, 0.0f, 0.0f));
+        // Every vertex carries 1 / maxVertices
+        setTotalCharge(count > 0 ? static_cast<Accum>(count) * (Accum(1) / count) : Accum(0));
+        if (getDebug()) {
+            LOG_DEBUG_CAT("Simulation", "Initialized {} vertices, vertexSpins_.size()={}",
+                          std::source_location::current(), count, vertexSpins_.size());
+        }
 
         if (!projectedVerts_.empty() && reinterpret_cast<std::uintptr_t>(projectedVerts_.data()) % alignof(glm::vec3) != 0) {
             LOG_ERROR_CAT("Simulation", "projectedVerts_ is misaligned: address={}, alignment={}",
@@ -353,11 +590,12 @@ void UniversalEquation::initializeNCube() {
     init_latch.wait();
 }
 
-void UniversalEquation::validateProjectedVertices() const {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::validateProjectedVertices() const {
     if (projectedVerts_.empty()) {
         LOG_WARNING_CAT("Simulation", "projectedVerts_ is empty, initializing with default values",
                         std::source_location::current());
-        const_cast<std::vector<glm::vec3>&>(projectedVerts_).resize(nCubeVertices_.size(), glm::vec3(0.0f, 0.0f, 0.0f));
+        const_cast<UE::SharedVector<glm::vec3>&>(projectedVerts_).resize(nCubeVertices_.size(), glm::vec3(0.0f, 0.0f, 0.0f));
     }
     if (projectedVerts_.size() != nCubeVertices_.size()) {
         LOG_ERROR_CAT("Simulation", "projectedVerts_ size mismatch: projectedVerts_.size()={}, nCubeVertices_.size()={}",
@@ -371,14 +609,15 @@ void UniversalEquation::validateProjectedVertices() const {
     }
 }
 
-long double UniversalEquation::computeKineticEnergy(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeKineticEnergy(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double kineticEnergy = 0.0L;
-    const auto& momentum = vertexMomenta_[vertexIndex];
-    for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
+    Accum kineticEnergy = Accum(0);
+    const auto momentum = vertexMomenta_[vertexIndex];
+    for (size_t j = 0; j < momentum.size(); ++j) {
         kineticEnergy += momentum[j] * momentum[j]; // Sum of squared momentum components
     }
-    kineticEnergy *= 0.5L * materialDensity_.load(); // KE = (1/2) * mass * v^2, assuming density as mass proxy
+    kineticEnergy *= Accum(0.5L) * getMaterialDensity(); // KE = (1/2) * mass * v^2, assuming density as mass proxy
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed kinetic energy for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, kineticEnergy);
@@ -386,148 +625,447 @@ long double UniversalEquation::computeKineticEnergy(int vertexIndex) const {
     return kineticEnergy;
 }
 
-void UniversalEquation::updateInteractions() {
-    LOG_INFO_CAT("Simulation", "Starting interaction update: vertices={}, dimension={}",
-                 std::source_location::current(), nCubeVertices_.size(), getCurrentDimension());
-    interactions_.clear();
-    projectedVerts_.clear();
-    LOG_DEBUG_CAT("Simulation", "Cleared interactions_ and projectedVerts_",
-                  std::source_location::current());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::markDirty(unsigned fields) {
+    if (fields == kDirtyNone) {
+        return;
+    }
+    dirty_.fetch_or(fields);
+    if (fields & (kDirtyStructure | kDirtyEnergySums)) {
+        energySumsStale_.store(true);
+    }
+    needsUpdate_.store(true);
+}
 
-    size_t d = static_cast<size_t>(getCurrentDimension());
-    uint64_t numVertices = std::min(static_cast<uint64_t>(nCubeVertices_.size()), getMaxVertices());
-    if (debug_.load()) {
-        LOG_DEBUG_CAT("Simulation", "Processing {} vertices (maxVertices_={})",
-                      std::source_location::current(), numVertices, getMaxVertices());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::markVertexDirty(size_t vertexIndex, unsigned fields) {
+    if (fields & kDirtyEnergySums) {
+        energySumsStale_.store(true);
+    }
+    if (vertexIndex >= vertexDirty_.size()) {
+        // Cache not built for this vertex yet; the next update rebuilds it anyway
+        markDirty(kDirtyStructure);
+        return;
+    }
+    const uint8_t cached = static_cast<uint8_t>(fields & (kDirtyGeometry | kDirtyVectorPotential | kDirtyGodWave));
+    if (vertexDirty_[vertexIndex] == 0 && cached != 0) {
+        dirtyVertices_.push_back(vertexIndex);
     }
+    vertexDirty_.mutate()[vertexIndex] |= cached;
+    needsUpdate_.store(true);
+}
 
-    std::vector<std::vector<UE::DimensionInteraction>> localInteractions(omp_get_max_threads());
-    std::vector<std::vector<glm::vec3>> localProjected(omp_get_max_threads());
-    for (int t = 0; t < omp_get_max_threads(); ++t) {
-        localInteractions[t].reserve(numVertices / omp_get_max_threads() + 1);
-        localProjected[t].reserve(numVertices / omp_get_max_threads() + 1);
-        if (debug_.load()) {
-            LOG_DEBUG_CAT("Simulation", "Thread {}: reserved {} elements for localInteractions and localProjected",
-                          std::source_location::current(), t, numVertices / omp_get_max_threads() + 1);
-        }
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::rebuildCentroidSum(size_t dimensions, uint64_t numVertices) {
+    centroidSum_.assign(dimensions, Accum(0));
+    for (size_t j = 0; j < dimensions; ++j) {
+        centroidSum_[j] = UE::reproducibleSum<Accum>(
+            std::span<const Real>(std::as_const(nCubeVertices_).plane(static_cast<int>(j)).first(numVertices)), reductionPartials_);
     }
+}
 
-    std::vector<long double> referenceVertex(d, 0.0L);
-    for (size_t i = 0; i < numVertices && i < nCubeVertices_.size(); ++i) {
-        validateVertexIndex(static_cast<int>(i));
-        for (size_t j = 0; j < d; ++j) {
-            referenceVertex[j] += nCubeVertices_[i][j];
-        }
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::updateInteractions() {
+    const size_t d = static_cast<size_t>(std::min(getCurrentDimension(), nCubeVertices_.dimensions()));
+    const uint64_t numVertices = std::min(static_cast<uint64_t>(nCubeVertices_.size()), getMaxVertices());
+    const size_t vecPotDims = static_cast<size_t>(std::min(3, getCurrentDimension()));
+    unsigned fields = dirty_.exchange(kDirtyNone);
+
+    const bool rebuild = (fields & kDirtyStructure) || interactions_.size() != numVertices ||
+                         projectedVerts_.size() != numVertices || vertexDirty_.size() != numVertices ||
+                         centroidSum_.size() != d ||
+                         interactions_.vectorPotentialDims() != static_cast<int>(vecPotDims);
+    if (rebuild) {
+        // Columns are laid out by vertex index and only reallocated when the vertex count changes
+        interactions_.resize(numVertices);
+        interactions_.setVectorPotentialDims(static_cast<int>(vecPotDims));
+        projectedVerts_.resize(numVertices);
+        vertexDirty_ = std::vector<uint8_t>(numVertices, 0);
+        dirtyVertices_.clear();
+        centroid_.clear();
+        rebuildCentroidSum(d, numVertices);
+        fields = kDirtyDistance | kDirtyStrength | kDirtyProjection | kDirtyVectorPotential | kDirtyGodWave;
     }
+
+    // Distances only need a full pass when the centroid actually moved
+    std::vector<Accum> centroid(d, Accum(0));
     for (size_t j = 0; j < d; ++j) {
-        referenceVertex[j] = safe_div(referenceVertex[j], static_cast<long double>(numVertices));
-    }
-    long double trans = getPerspectiveTrans();
-    long double focal = getPerspectiveFocal();
-    size_t depthIdx = d > 0 ? d - 1 : 0;
-    long double depthRef = referenceVertex[depthIdx] + trans;
-    if (depthRef <= 0.0L) {
-        depthRef = 0.001L;
+        centroid[j] = safe_div(centroidSum_[j], static_cast<Accum>(numVertices));
+    }
+    if (centroid != centroid_) {
+        fields |= kDirtyDistance;
+        centroid_ = std::move(centroid);
+    }
+    if (fields & kDirtyDistance) {
+        fields |= kDirtyStrength;
+    }
+    fields &= kDirtyDistance | kDirtyStrength | kDirtyProjection | kDirtyVectorPotential | kDirtyGodWave;
+    if (fields == kDirtyNone && dirtyVertices_.empty()) {
+        return;
+    }
+
+    const auto params = getParams();
+    const Accum trans = params->perspectiveTrans;
+    const Accum focal = params->perspectiveFocal;
+    const size_t momentumDims = std::min(vecPotDims, static_cast<size_t>(vertexMomenta_.dimensions()));
+    const size_t momentumCount = vertexMomenta_.size();
+    const size_t amplitudeCount = vertexWaveAmplitudes_.size();
+    const size_t depthIdx = d > 0 ? d - 1 : 0;
+    const size_t projDim = std::min<size_t>(3, d);
+    if ((fields & kDirtyProjection) && d > 0 && centroid_[depthIdx] + trans <= Accum(0)) {
         LOG_WARNING_CAT("Simulation", "Clamped depthRef to 0.001: original={}",
-                        std::source_location::current(), referenceVertex[depthIdx] + trans);
+                        std::source_location::current(), centroid_[depthIdx] + trans);
     }
 
-    std::latch latch(omp_get_max_threads());
-    #pragma omp parallel
-    {
-        int thread_id = omp_get_thread_num();
-        if (debug_.load()) {
-            LOG_DEBUG_CAT("Simulation", "Thread {}: processing vertices 0 to {}",
-                          std::source_location::current(), thread_id, numVertices);
-        }
-        #pragma omp for schedule(dynamic)
-        for (uint64_t i = 0; i < numVertices; ++i) {
-            if (i >= nCubeVertices_.size()) {
-                if (debug_.load()) {
-                    LOG_WARNING_CAT("Simulation", "Thread {}: skipping vertex {} (exceeds nCubeVertices_.size()={})",
-                                    std::source_location::current(), thread_id, i, nCubeVertices_.size());
+    // Writable pointers are taken here, before the parallel regions, so shared buffers are copied only once
+    const UE::VertexStore<Real>& positions = nCubeVertices_;
+    const UE::VertexStore<Real>& momenta = vertexMomenta_;
+    glm::vec3* const projectedOut = projectedVerts_.mutate().data();
+    uint8_t* const vertexDirty = vertexDirty_.mutate().data();
+    Real* const distanceOut = interactions_.distance().data();
+    Real* const strengthOut = interactions_.strength().data();
+    Real* const godWaveOut = interactions_.godWaveAmplitude().data();
+    std::array<Real*, UE::InteractionStore<Real>::kVectorPotentialDims> vecPotOut{};
+    for (size_t k = 0; k < vecPotDims; ++k) {
+        vecPotOut[k] = interactions_.vectorPotential(static_cast<int>(k)).data();
+    }
+
+    // Inlined computeInteraction / computeVectorPotential / computeGodWave against the snapshot. Every entry is
+    // written in place at its vertex index, so the result does not depend on the thread count. The passes are
+    // instantiated per dimension count so the distance loop has a fixed trip count.
+    const size_t dirtyCount = dirtyVertices_.size();
+    UE::dispatchDimension(static_cast<int>(d), [&](auto dims) {
+        const size_t dn = UE::activeDimensions<decltype(dims)::value>(d);
+        auto refresh = [&](uint64_t i, unsigned mask) {
+            if (mask & kDirtyDistance) {
+                Accum distance = Accum(0);
+                for (size_t j = 0; j < dn; ++j) {
+                    const Accum diff = positions.plane(static_cast<int>(j))[i] - centroid_[j];
+                    distance += diff * diff;
                 }
-                continue;
-            }
-            validateVertexIndex(static_cast<int>(i));
-            const auto& v = nCubeVertices_[i];
-            long double depthI = v[depthIdx] + trans;
-            if (depthI <= 0.0L) {
-                depthI = 0.001L;
-                if (debug_.load()) {
-                    LOG_WARNING_CAT("Simulation", "Thread {}: clamped depthI to 0.001 for vertex {}",
-                                    std::source_location::current(), thread_id, i);
+                distance = std::sqrt(distance);
+                if (distance <= Accum(0) || std::isnan(distance) || std::isinf(distance)) {
+                    distance = Accum(1e-10L);
                 }
+                distanceOut[i] = static_cast<Real>(distance);
+            }
+            if (mask & (kDirtyDistance | kDirtyStrength)) {
+                strengthOut[i] = static_cast<Real>(
+                    params->influence * safe_div(Accum(1), static_cast<Accum>(distanceOut[i]) + Accum(1e-10L)));
             }
-            long double scaleI = safe_div(focal, depthI);
-            long double distance = 0.0L;
-            for (size_t j = 0; j < d; ++j) {
-                long double diff = v[j] - referenceVertex[j];
-                distance += diff * diff;
+            if (mask & kDirtyProjection) {
+                Accum depthI = (d > 0 ? positions.plane(static_cast<int>(depthIdx))[i] : Accum(0)) + trans;
+                if (depthI <= Accum(0)) {
+                    depthI = Accum(0.001L);
+                }
+                const Accum scaleI = safe_div(focal, depthI);
+                glm::vec3 projIVec(0.0f);
+                for (size_t k = 0; k < projDim; ++k) {
+                    projIVec[k] = static_cast<float>(positions.plane(static_cast<int>(k))[i] * scaleI);
+                }
+                projectedOut[i] = projIVec;
             }
-            distance = std::sqrt(distance);
-            if (distance <= 0.0L || std::isnan(distance) || std::isinf(distance)) {
-                distance = 1e-10L;
-                if (debug_.load()) {
-                    LOG_WARNING_CAT("Simulation", "Thread {}: invalid distance for vertex {}, using default={}",
-                                    std::source_location::current(), thread_id, i, distance);
+            if (mask & kDirtyVectorPotential) {
+                for (size_t k = 0; k < vecPotDims; ++k) {
+                    vecPotOut[k][i] = (k < momentumDims && i < momentumCount)
+                        ? static_cast<Real>(momenta.plane(static_cast<int>(k))[i] * params->weak) : Real(0);
                 }
             }
-            long double strength = computeInteraction(static_cast<int>(i), distance);
-            auto vecPot = computeVectorPotential(static_cast<int>(i));
-            long double godWaveAmp = computeGodWave(static_cast<int>(i));
-            glm::vec3 projIVec(0.0f);
-            size_t projDim = std::min<size_t>(3, d);
-            for (size_t k = 0; k < projDim; ++k) {
-                projIVec[k] = static_cast<float>(v[k] * scaleI);
+            if (mask & kDirtyGodWave) {
+                const Accum amplitude = i < amplitudeCount ? static_cast<Accum>(vertexWaveAmplitudes_[i]) : Accum(0);
+                godWaveOut[i] = static_cast<Real>(params->godWaveFreq * amplitude * Accum(0.1L));
+            }
+        };
+
+        if (fields != kDirtyNone) {
+            #pragma omp parallel for schedule(static)
+            for (uint64_t i = 0; i < numVertices; ++i) {
+                refresh(i, fields);
+            }
+        }
+        // Single-vertex edits whose fields the full pass above did not already cover
+        #pragma omp parallel for schedule(static)
+        for (size_t n = 0; n < dirtyCount; ++n) {
+            const size_t i = dirtyVertices_[n];
+            unsigned mask = vertexDirty[i];
+            if (mask & kDirtyDistance) {
+                mask |= kDirtyStrength;
             }
-            localInteractions[thread_id].emplace_back(static_cast<int>(i), distance, strength, vecPot, godWaveAmp);
-            localProjected[thread_id].push_back(projIVec);
+            mask &= ~fields;
+            if (mask != kDirtyNone) {
+                refresh(i, mask);
+            }
+            vertexDirty[i] = 0;
         }
-        latch.count_down();
+    });
+    dirtyVertices_.clear();
+
+    LOG_DEBUG_CAT("Simulation", "Interactions updated: rebuild={}, fields={}, dirtyVertices={}, vertices={}",
+                  std::source_location::current(), rebuild, fields, dirtyCount, numVertices);
+    validateProjectedVertices();
+}
+
+template<typename Real, typename Accum>
+typename UniversalEquationT<Real, Accum>::EnergyPass UniversalEquationT<Real, Accum>::prepareEnergyPass(
+    const UE::VertexStore<Real>& positions, const UE::VertexStore<Real>& momenta, const std::vector<Real>& spins,
+    const std::vector<Real>& amplitudes, int dimensions, Accum influence, int strata, EnergyScratch& scratch,
+    bool trackVertices, const UE::MeanFieldGravity<Real, Accum>* meanField, Accum meanFieldWeight) {
+    EnergyPass pass;
+    pass.positions = &positions;
+    pass.momenta = &momenta;
+    pass.spins = spins.data();
+    pass.amplitudes = amplitudes.data();
+    pass.count = positions.size();
+    pass.dimensions = std::min(dimensions, positions.dimensions());
+    pass.influence = influence;
+    pass.meanField = meanField;
+    pass.meanFieldWeight = meanField ? std::clamp(meanFieldWeight, Accum(0), Accum(1)) : Accum(0);
+    // The specialised block kernel loops over one count, so it is only used when momenta match the positions
+    static constexpr auto kEnergyBlocks = UE::makeDimensionTable(
+        [](auto dims) { return &UniversalEquationT::template energyBlockFor<decltype(dims)::value, false>; });
+    pass.kernel = kEnergyBlocks[momenta.dimensions() == pass.dimensions ? UE::dimensionSlot(pass.dimensions) : 0];
+    finishEnergyPass(pass, strata, scratch, trackVertices);
+    return pass;
+}
+
+template<typename Real, typename Accum>
+typename UniversalEquationT<Real, Accum>::EnergyPass UniversalEquationT<Real, Accum>::prepareEnergyPass(
+    const UE::ProceduralVertices<Real, Accum>& vertices, int dimensions, Accum influence, int strata,
+    EnergyScratch& scratch, bool trackVertices, const UE::MeanFieldGravity<Real, Accum>* meanField,
+    Accum meanFieldWeight) {
+    EnergyPass pass;
+    pass.procedural = &vertices;
+    pass.count = vertices.size();
+    pass.dimensions = std::min(dimensions, vertices.dimensions());
+    pass.influence = influence;
+    pass.meanField = meanField;
+    pass.meanFieldWeight = meanField ? std::clamp(meanFieldWeight, Accum(0), Accum(1)) : Accum(0);
+    // Implicit momenta always have as many components as the positions
+    static constexpr auto kEnergyBlocks = UE::makeDimensionTable(
+        [](auto dims) { return &UniversalEquationT::template energyBlockFor<decltype(dims)::value, true>; });
+    pass.kernel = kEnergyBlocks[vertices.dimensions() == pass.dimensions ? UE::dimensionSlot(pass.dimensions) : 0];
+    finishEnergyPass(pass, strata, scratch, trackVertices);
+    return pass;
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::finishEnergyPass(EnergyPass& pass, int strata, EnergyScratch& scratch,
+                                                       bool trackVertices) {
+    // The vertex range is cut into equal-count strata and every round draws one partner from each, weighted by
+    // the stratum size, which keeps the estimate unbiased. The draws are shared by all vertices of a round so their
+    // coordinates can be gathered into a contiguous block and the inner loops stay unit-stride.
+    pass.strata = static_cast<size_t>(std::min<uint64_t>(
+        pass.count, static_cast<uint64_t>(std::clamp<int>(strata, 1, static_cast<int>(kMaxEnergyStrata)))));
+    scratch.sampleIndex.resize(pass.strata);
+    scratch.sampleWeight.resize(pass.strata);
+    for (size_t h = 0; h < pass.strata; ++h) {
+        scratch.sampleWeight[h] = static_cast<Accum>(UE::stratumBegin(pass.count, pass.strata, h + 1) -
+                                                     UE::stratumBegin(pass.count, pass.strata, h));
+    }
+    scratch.gathered.resize(pass.strata, pass.dimensions);
+    pass.sampleIndex = scratch.sampleIndex.data();
+    pass.sampleWeight = scratch.sampleWeight.data();
+    pass.gathered = &scratch.gathered;
+    // Each fixed-size block is summed by one thread and the block totals are folded in a fixed order, so the
+    // result is bit-identical for any thread count or scheduler
+    pass.blocks = UE::reductionBlocks(static_cast<size_t>(pass.count));
+    scratch.partials.resize(pass.blocks * kEnergyTerms);
+    pass.partials = scratch.partials.data();
+    if (trackVertices) {
+        scratch.vertexMean.resize(pass.count);
+        scratch.vertexM2.resize(pass.count);
+        pass.vertexMean = scratch.vertexMean.mutate().data();
+        pass.vertexM2 = scratch.vertexM2.mutate().data();
     }
-    latch.wait();
+}
 
-    size_t totalInteractions = 0;
-    size_t totalProjected = 0;
-    for (int t = 0; t < omp_get_max_threads(); ++t) {
-        totalInteractions += localInteractions[t].size();
-        totalProjected += localProjected[t].size();
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::drawEnergySamples(const EnergyPass& pass, EnergyScratch& scratch, uint64_t seed) {
+    for (size_t h = 0; h < pass.strata; ++h) {
+        scratch.sampleIndex[h] = UE::stratifiedSample(seed, static_cast<uint64_t>(pass.round), pass.count,
+                                                      pass.strata, h);
     }
-    interactions_.reserve(totalInteractions);
-    projectedVerts_.reserve(totalProjected);
-    for (int t = 0; t < omp_get_max_threads(); ++t) {
-        interactions_.insert(interactions_.end(), localInteractions[t].begin(), localInteractions[t].end());
-        projectedVerts_.insert(projectedVerts_.end(), localProjected[t].begin(), localProjected[t].end());
+    if (pass.procedural) {
+        for (size_t h = 0; h < pass.strata; ++h) {
+            const auto vertex = (*pass.procedural)[scratch.sampleIndex[h]];
+            for (int k = 0; k < pass.dimensions; ++k) {
+                scratch.gathered.plane(k)[h] = static_cast<Accum>(vertex.coordinate(static_cast<size_t>(k)));
+            }
+        }
+        return;
     }
-    LOG_INFO_CAT("Simulation", "Interactions updated: interactions_.size()={}, projectedVerts_.size()={}",
-                 std::source_location::current(), interactions_.size(), projectedVerts_.size());
-    if (totalInteractions != totalProjected || totalInteractions != interactions_.size() || totalProjected != projectedVerts_.size()) {
-        LOG_ERROR_CAT("Simulation", "Mismatch in merged sizes: expected interactions={}, projected={}, actual interactions_.size()={}, projectedVerts_.size()={}",
-                      std::source_location::current(), totalInteractions, totalProjected, interactions_.size(), projectedVerts_.size());
-        throw std::runtime_error("Mismatch in merged vector sizes");
+    for (int k = 0; k < pass.dimensions; ++k) {
+        auto coords = pass.positions->plane(k);
+        auto out = scratch.gathered.plane(k);
+        for (size_t h = 0; h < pass.strata; ++h) {
+            out[h] = static_cast<Accum>(coords[scratch.sampleIndex[h]]);
+        }
     }
-    validateProjectedVertices();
 }
 
-UE::EnergyResult UniversalEquation::compute() {
-    LOG_INFO_CAT("Simulation", "Starting compute: vertices={}, dimension={}",
-                 std::source_location::current(), nCubeVertices_.size(), getCurrentDimension());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::energyBlock(const EnergyPass& pass, size_t block) noexcept {
+    pass.kernel(pass, block);
+}
+
+template<typename Real, typename Accum>
+template<int Dims, bool Procedural>
+void UniversalEquationT<Real, Accum>::energyBlockFor(const EnergyPass& pass, size_t block) noexcept {
+    const size_t d = UE::activeDimensions<Dims>(static_cast<size_t>(pass.dimensions));
+    const size_t momentumDims = UE::activeDimensions<Dims>(static_cast<size_t>(
+        Procedural ? pass.procedural->dimensions() : pass.momenta->dimensions()));
+    const bool scalarTerms = pass.round == 0;
+    const bool sampled = pass.meanFieldWeight < Accum(1);
+    const Accum rounds = static_cast<Accum>(pass.round + 1);
+    UE::CompensatedSum<Accum> potentialSum;
+    UE::CompensatedSum<Accum> amplitudeSum;
+    UE::CompensatedSum<Accum> spinSum;
+    UE::CompensatedSum<Accum> momentumSquaredSum;
+    const uint64_t blockEnd = std::min<uint64_t>(pass.count, (block + 1) * UE::kReductionBlock);
+    for (uint64_t i = block * UE::kReductionBlock; i < blockEnd; ++i) {
+        Accum totalPotential = Accum(0);
+        if (sampled) {
+            std::array<Accum, kMaxEnergyStrata> dist2;
+            std::fill_n(dist2.begin(), pass.strata, Accum(0));
+            for (size_t k = 0; k < d; ++k) {
+                Accum xi;
+                if constexpr (Procedural) {
+                    xi = static_cast<Accum>(pass.procedural->coordinate(i, static_cast<int>(k)));
+                } else {
+                    xi = static_cast<Accum>(pass.positions->plane(static_cast<int>(k))[i]);
+                }
+                const Accum* gathered = pass.gathered->plane(static_cast<int>(k)).data();
+                for (size_t s = 0; s < pass.strata; ++s) {
+                    Accum diff = gathered[s] - xi;
+                    dist2[s] += diff * diff;
+                }
+            }
+            for (size_t s = 0; s < pass.strata; ++s) {
+                Accum distance = std::sqrt(dist2[s]);
+                if (!(distance > Accum(0)) || std::isinf(distance)) {
+                    distance = Accum(1e-10L);
+                }
+                // A draw of vertex i itself is a self-interaction and contributes nothing
+                totalPotential += pass.sampleIndex[s] == i ? Accum(0) : -pass.influence / distance * pass.sampleWeight[s];
+            }
+        }
+        if (pass.meanFieldWeight > Accum(0)) {
+            Accum meanFieldPotential;
+            if constexpr (Procedural) {
+                meanFieldPotential = pass.meanField->potential(*pass.procedural, i, pass.influence);
+            } else {
+                meanFieldPotential = pass.meanField->potential(*pass.positions, i, pass.influence);
+            }
+            totalPotential = (Accum(1) - pass.meanFieldWeight) * totalPotential + pass.meanFieldWeight * meanFieldPotential;
+        }
+        if (std::isnan(totalPotential) || std::isinf(totalPotential)) {
+            totalPotential = Accum(0);
+        }
+        potentialSum.add(totalPotential);
+        if (pass.vertexMean) {
+            if (scalarTerms) {
+                pass.vertexMean[i] = totalPotential;
+                pass.vertexM2[i] = Accum(0);
+            } else {
+                UE::welfordUpdate(pass.vertexMean[i], pass.vertexM2[i], totalPotential, rounds);
+            }
+        }
+        if (!scalarTerms) {
+            continue;
+        }
+
+        Accum momentumSquared = Accum(0);
+        if constexpr (Procedural) {
+            const auto vertex = (*pass.procedural)[i];
+            amplitudeSum.add(vertex.amplitude());
+            spinSum.add(vertex.spin());
+            for (size_t k = 0; k < momentumDims; ++k) {
+                Accum p = vertex.momentum(k);
+                momentumSquared += p * p;
+            }
+        } else {
+            amplitudeSum.add(pass.amplitudes[i]);
+            spinSum.add(pass.spins[i]);
+            for (size_t k = 0; k < momentumDims; ++k) {
+                Accum p = pass.momenta->plane(static_cast<int>(k))[i];
+                momentumSquared += p * p;
+            }
+        }
+        momentumSquaredSum.add(momentumSquared);
+    }
+    pass.partials[kPotentialTerm * pass.blocks + block] = potentialSum.value();
+    if (scalarTerms) {
+        pass.partials[kAmplitudeTerm * pass.blocks + block] = amplitudeSum.value();
+        pass.partials[kSpinTerm * pass.blocks + block] = spinSum.value();
+        pass.partials[kMomentumSquaredTerm * pass.blocks + block] = momentumSquaredSum.value();
+    }
+}
+
+template<typename Real, typename Accum>
+template<typename ForBlocks>
+typename UniversalEquationT<Real, Accum>::EnergySums UniversalEquationT<Real, Accum>::runEnergyPass(
+    EnergyPass& pass, EnergyScratch& scratch, const UE::Params<Accum>& params, ForBlocks&& forBlocks) {
+    auto fold = [&](size_t term) {
+        return UE::pairwiseSum(std::span<const Accum>(pass.partials + term * pass.blocks, pass.blocks));
+    };
+    EnergySums sums{};
+    // Rounds are independent estimates of the total potential, so their spread gives the standard error of the
+    // mean. Refinement stops once it is within the target relative error, after at least two rounds. The
+    // mean-field term alone is deterministic and needs one.
+    const int maxRounds = pass.meanFieldWeight < Accum(1) ? std::max(2, params.potentialMaxRounds) : 1;
+    Accum mean = Accum(0);
+    Accum m2 = Accum(0);
+    int rounds = 0;
+    while (rounds < maxRounds) {
+        pass.round = rounds;
+        drawEnergySamples(pass, scratch, params.potentialSeed);
+        forBlocks(static_cast<const EnergyPass&>(pass));
+        if (rounds == 0) {
+            sums.amplitude = fold(kAmplitudeTerm);
+            sums.spin = fold(kSpinTerm);
+            sums.momentumSquared = fold(kMomentumSquaredTerm);
+        }
+        ++rounds;
+        UE::welfordUpdate(mean, m2, fold(kPotentialTerm), static_cast<Accum>(rounds));
+        if (rounds >= 2 && std::sqrt(m2 / static_cast<Accum>(rounds - 1) / static_cast<Accum>(rounds)) <=
+                               params.potentialTargetError * std::abs(mean)) {
+            break;
+        }
+    }
+    sums.potential = mean;
+    sums.potentialVariance = rounds > 1 ? m2 / static_cast<Accum>(rounds - 1) / static_cast<Accum>(rounds) : Accum(0);
+    sums.potentialRounds = rounds;
+    return sums;
+}
+
+template<typename Real, typename Accum>
+UE::EnergyResult UniversalEquationT<Real, Accum>::energyFromSums(const EnergySums& sums, uint64_t count,
+                                                                 const UE::Params<Accum>& params) const {
+    UE::EnergyResult result{Accum(0), sums.potential,
+                            params.nurbMatterStrength * Accum(0.5L) * sums.amplitude,
+                            params.nurbEnergyStrength * Accum(0.3L) * sums.amplitude,
+                            params.spinInteraction * Accum(0.2L) * sums.spin,
+                            Accum(0.5L) * params.materialDensity * sums.momentumSquared,
+                            params.emFieldStrength * Accum(0.01L) * sums.amplitude,
+                            params.godWaveFreq * Accum(0.1L) * sums.amplitude};
+    result.observable = safe_div(result.potential + result.nurbMatter + result.nurbEnergy + result.spinEnergy +
+                                 result.momentumEnergy + result.fieldEnergy + result.GodWaveEnergy,
+                                 static_cast<Accum>(count));
+    result.potentialError = std::sqrt(sums.potentialVariance);
+    result.potentialRounds = sums.potentialRounds;
+    return result;
+}
+
+template<typename Real, typename Accum>
+UE::EnergyResult UniversalEquationT<Real, Accum>::compute() {
+    LOG_DEBUG_CAT("Simulation", "Starting compute: vertices={}, dimension={}",
+                  std::source_location::current(), nCubeVertices_.size(), getCurrentDimension());
     if (getNeedsUpdate()) {
         updateInteractions();
         needsUpdate_.store(false);
     }
 
-    UE::EnergyResult result{0.0L, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L, 0.0L};
-    uint64_t numVertices = std::min(static_cast<uint64_t>(nCubeVertices_.size()), getMaxVertices());
-    std::vector<long double> potentials(numVertices, 0.0L);
-    std::vector<long double> nurbMatters(numVertices, 0.0L);
-    std::vector<long double> nurbEnergies(numVertices, 0.0L);
-    std::vector<long double> spinEnergies(numVertices, 0.0L);
-    std::vector<long double> momentumEnergies(numVertices, 0.0L);
-    std::vector<long double> fieldEnergies(numVertices, 0.0L);
-    std::vector<long double> godWaveEnergies(numVertices, 0.0L);
-
+    const uint64_t numVertices = std::min(static_cast<uint64_t>(nCubeVertices_.size()), getMaxVertices());
     if (nCubeVertices_.size() != numVertices || vertexMomenta_.size() != numVertices ||
         vertexSpins_.size() != numVertices || vertexWaveAmplitudes_.size() != numVertices) {
         LOG_ERROR_CAT("Simulation", "Vector size mismatch: nCubeVertices_={}, vertexMomenta_={}, vertexSpins_={}, vertexWaveAmplitudes_={}",
@@ -535,117 +1073,100 @@ UE::EnergyResult UniversalEquation::compute() {
         throw std::runtime_error("Vector size mismatch in compute");
     }
 
-    std::latch latch(omp_get_max_threads());
-    #pragma omp parallel
-    {
-        int thread_id = omp_get_thread_num();
-        if (debug_.load()) {
-            LOG_DEBUG_CAT("Simulation", "Thread {}: computing energies for vertices",
-                          std::source_location::current(), thread_id);
+    // Parameter snapshot, read once per call
+    const auto params = getParams();
+    // The vertex pass only runs when positions, momenta or influence changed. Every other term is a parameter
+    // times the spin or amplitude total, which the setters keep current, so the result is assembled in O(1).
+    const bool fullPass = energySumsStale_.exchange(false);
+    if (fullPass) {
+        const bool meanField = params->meanFieldApprox > Accum(0);
+        if (meanField) {
+            meanField_.fit(nCubeVertices_, getCurrentDimension());
         }
-        #pragma omp for schedule(dynamic) nowait
-        for (uint64_t i = 0; i < numVertices; ++i) {
-            if (i >= nCubeVertices_.size()) {
-                if (debug_.load()) {
-                    LOG_WARNING_CAT("Simulation", "Thread {}: skipping vertex {} (exceeds nCubeVertices_.size()={})",
-                                    std::source_location::current(), thread_id, i, nCubeVertices_.size());
-                }
-                continue;
-            }
-            validateVertexIndex(static_cast<int>(i));
-            long double totalPotential = 0.0L;
-            uint64_t sampleStep = std::max<uint64_t>(1, numVertices / 100); // Sample ~100 pairs per vertex
-            for (uint64_t j = 0; j < numVertices && j < nCubeVertices_.size(); j += sampleStep) {
-                if (static_cast<int>(j) == static_cast<int>(i)) continue;
-                try {
-                    totalPotential += computeGravitationalPotential(static_cast<int>(i), static_cast<int>(j));
-                } catch (const std::out_of_range& e) {
-                    if (debug_.load()) {
-                        LOG_WARNING_CAT("Simulation", "Thread {}: skipping invalid vertex pair ({}, {}): {}",
-                                        std::source_location::current(), thread_id, i, j, e.what());
-                    }
-                    continue;
-                }
-            }
-            totalPotential *= static_cast<long double>(sampleStep);
-            if (std::isnan(totalPotential) || std::isinf(totalPotential)) {
-                if (debug_.load()) {
-                    LOG_WARNING_CAT("Simulation", "Thread {}: invalid totalPotential for vertex {}: {}, resetting to 0",
-                                    std::source_location::current(), thread_id, i, totalPotential);
+        EnergyPass pass = prepareEnergyPass(nCubeVertices_, vertexMomenta_, vertexSpins_.vector(),
+                                            vertexWaveAmplitudes_.vector(), getCurrentDimension(),
+                                            params->influence, params->potentialStrata, energyScratch_, true,
+                                            meanField ? &meanField_ : nullptr, params->meanFieldApprox);
+        energySums_ = runEnergyPass(pass, energyScratch_, *params, [this](const EnergyPass& round) {
+            // Blocks are independent, so streaming mapped planes window by window leaves the sums unchanged
+            UE::streamResident(round.count, UE::kReductionBlock, [&](uint64_t begin, uint64_t end) {
+                const size_t lastBlock = UE::reductionBlocks(static_cast<size_t>(end));
+                #pragma omp parallel for schedule(static)
+                for (size_t b = begin / UE::kReductionBlock; b < lastBlock; ++b) {
+                    energyBlock(round, b);
                 }
-                totalPotential = 0.0L;
-            }
-            potentials[i] = totalPotential;
-
-            nurbMatters[i] = computeNurbMatter(static_cast<int>(i));
-            nurbEnergies[i] = computeNurbEnergy(static_cast<int>(i));
-            spinEnergies[i] = computeSpinEnergy(static_cast<int>(i));
-            momentumEnergies[i] = computeKineticEnergy(static_cast<int>(i));
-            fieldEnergies[i] = computeEMField(static_cast<int>(i));
-            godWaveEnergies[i] = computeGodWave(static_cast<int>(i));
+            }, nCubeVertices_, vertexMomenta_);
+        });
+    }
+    const UE::EnergyResult result = energyFromSums(energySums_, numVertices, *params);
+    LOG_DEBUG_CAT("Simulation", "Compute completed (fullPass={}): {}", std::source_location::current(), fullPass,
+                  result.toString());
+    return result;
+}
+
+template<typename Real, typename Accum>
+UE::EnergyResult UniversalEquationT<Real, Accum>::compute(const UE::ProceduralVertices<Real, Accum>& vertices) const {
+    const int dim = std::clamp(vertices.dimensions(), 1, maxDimensions_);
+    LOG_DEBUG_CAT("Simulation", "Starting implicit compute: vertices={}, dimension={}, overrides={}",
+                  std::source_location::current(), vertices.size(), dim, vertices.overlaySize());
+    if (vertices.empty()) {
+        LOG_ERROR_CAT("Simulation", "Implicit compute on an empty vertex set", std::source_location::current());
+        throw std::invalid_argument("compute: empty vertex set");
+    }
+    const auto params = getParams();
+    UE::MeanFieldGravity<Real, Accum> meanField;
+    if (params->meanFieldApprox > Accum(0)) {
+        meanField.fit(vertices, dim);
+    }
+    EnergyScratch scratch;
+    EnergyPass pass = prepareEnergyPass(vertices, dim, params->influence, params->potentialStrata, scratch, false,
+                                        &meanField, params->meanFieldApprox);
+    const EnergySums sums = runEnergyPass(pass, scratch, *params, [](const EnergyPass& round) {
+        #pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < round.blocks; ++b) {
+            energyBlock(round, b);
         }
-        latch.count_down();
-    }
-    latch.wait();
-
-    for (uint64_t i = 0; i < numVertices && i < nCubeVertices_.size(); ++i) {
-        result.observable += potentials[i] + nurbMatters[i] + nurbEnergies[i] + spinEnergies[i] + momentumEnergies[i] + fieldEnergies[i] + godWaveEnergies[i];
-        result.potential += potentials[i];
-        result.nurbMatter += nurbMatters[i];
-        result.nurbEnergy += nurbEnergies[i];
-        result.spinEnergy += spinEnergies[i];
-        result.momentumEnergy += momentumEnergies[i];
-        result.fieldEnergy += fieldEnergies[i];
-        result.GodWaveEnergy += godWaveEnergies[i];
-    }
-    result.observable = safe_div(result.observable, static_cast<long double>(numVertices));
-    LOG_INFO_CAT("Simulation", "Compute completed: {}", std::source_location::current(), result.toString());
+    });
+    const UE::EnergyResult result = energyFromSums(sums, vertices.size(), *params);
+    LOG_DEBUG_CAT("Simulation", "Implicit compute completed: {}", std::source_location::current(), result.toString());
     return result;
 }
 
-void UniversalEquation::initializeWithRetry() {
-    std::latch retry_latch(1);
-    int attempts = 0;
-    const int maxAttempts = 5;
-    uint64_t currentVertices = getMaxVertices();
-    while (getCurrentDimension() >= 1 && attempts < maxAttempts) {
-        try {
-            if (nCubeVertices_.size() > currentVertices) {
-                nCubeVertices_.resize(currentVertices);
-                vertexMomenta_.resize(currentVertices);
-                vertexSpins_.resize(currentVertices);
-                vertexWaveAmplitudes_.resize(currentVertices);
-                interactions_.resize(currentVertices, UE::DimensionInteraction(0, 0.0L, 0.0L, std::vector<long double>(std::min(3, getCurrentDimension()), 0.0L), 0.0L));
-                projectedVerts_.resize(currentVertices);
-            }
-            initializeNCube();
-            cachedCos_.resize(getMaxDimensions() + 1);
-            for (int i = 0; i <= getMaxDimensions(); ++i) {
-                cachedCos_[i] = std::cos(getOmega() * i);
-            }
-            updateInteractions();
-            validateProjectedVertices();
-            LOG_INFO_CAT("Simulation", "Initialization completed successfully", std::source_location::current());
-            retry_latch.count_down();
-            return;
-        } catch (const std::bad_alloc& e) {
-            LOG_WARNING_CAT("Simulation", "Memory allocation failed for dimension {}. Reducing dimension to {}. Attempt {}/{}",
-                            std::source_location::current(), getCurrentDimension(), getCurrentDimension() - 1, attempts + 1, maxAttempts);
-            if (getCurrentDimension() == 1) {
-                LOG_ERROR_CAT("Simulation", "Failed to allocate memory even at dimension 1", std::source_location::current());
-                throw std::runtime_error("Failed to allocate memory even at dimension 1");
-            }
-            setCurrentDimension(getCurrentDimension() - 1);
-            currentVertices = std::max<uint64_t>(1ULL, currentVertices / 2);
-            needsUpdate_.store(true);
-            ++attempts;
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::initializeWithRetry() {
+    // A failed allocation is reported, not retried with fewer vertices or dimensions: a smaller lattice would be a
+    // different experiment. Mapped storage is the way to run lattices larger than memory.
+    try {
+        initializeNCube();
+        cachedCos_.resize(getMaxDimensions() + 1);
+        for (int i = 0; i <= getMaxDimensions(); ++i) {
+            cachedCos_[i] = std::cos(getOmega() * i);
         }
+        updateInteractions();
+        validateProjectedVertices();
+        LOG_INFO_CAT("Simulation", "Initialization completed successfully", std::source_location::current());
+    } catch (const std::bad_alloc& e) {
+        LOG_ERROR_CAT("Simulation", "Out of memory initializing {} vertices in dimension {}{}",
+                      std::source_location::current(), getMaxVertices(), getCurrentDimension(),
+                      vertexStorage_.mapped() ? "" : "; consider UE::VertexStorage::Backing::Mapped");
+        throw std::runtime_error("Out of memory initializing " + std::to_string(getMaxVertices()) + " vertices");
+    }
+}
+
+template<typename Real, typename Accum>
+uint64_t UniversalEquationT<Real, Accum>::checkedVertexCount(uint64_t numVertices, const UE::VertexStorage& storage) {
+    const uint64_t limit = UE::maxVertices(storage);
+    if (numVertices > limit) {
+        LOG_ERROR_CAT("Simulation", "numVertices={} exceeds the {} storage limit of {}{}",
+                      std::source_location::current(), numVertices, storage.mapped() ? "mapped" : "heap", limit,
+                      storage.mapped() ? "" : "; use UE::VertexStorage::Backing::Mapped for larger lattices");
+        throw std::invalid_argument("numVertices exceeds the vertex storage limit");
     }
-    LOG_ERROR_CAT("Simulation", "Max retry attempts reached for initialization", std::source_location::current());
-    throw std::runtime_error("Max retry attempts reached for initialization");
+    return std::max<uint64_t>(1ULL, numVertices);
 }
 
-void UniversalEquation::initializeCalculator(AMOURANTH* amouranth) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::initializeCalculator(AMOURANTH* amouranth) {
     LOG_INFO_CAT("Simulation", "Initializing calculator with AMOURANTH={}",
                  std::source_location::current(), static_cast<void*>(amouranth));
     try {
@@ -662,7 +1183,7 @@ void UniversalEquation::initializeCalculator(AMOURANTH* amouranth) {
             LOG_WARNING_CAT("Simulation", "AMOURANTH is null, skipping navigator initialization",
                             std::source_location::current());
         }
-        needsUpdate_.store(true);
+        markDirty(kDirtyStructure);
         initializeWithRetry();
         validateProjectedVertices();
     } catch (const std::exception& e) {
@@ -671,15 +1192,17 @@ void UniversalEquation::initializeCalculator(AMOURANTH* amouranth) {
     }
 }
 
-void UniversalEquation::setGodWaveFreq(long double value) {
-    godWaveFreq_.store(std::clamp(value, 0.1L, 10.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set godWaveFreq: value={}", std::source_location::current(), godWaveFreq_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setGodWaveFreq(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0.1L), Accum(10));
+    updateParams([clamped](UE::Params<Accum>& p) { p.godWaveFreq = clamped; }, kDirtyGodWave);
+    LOG_DEBUG_CAT("Simulation", "Set godWaveFreq: value={}", std::source_location::current(), clamped);
 }
 
-long double UniversalEquation::computeNurbMatter(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeNurbMatter(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double result = getNurbMatterStrength() * vertexWaveAmplitudes_[vertexIndex] * 0.5L;
+    Accum result = getNurbMatterStrength() * vertexWaveAmplitudes_[vertexIndex] * Accum(0.5L);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed NURB matter for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, result);
@@ -687,9 +1210,10 @@ long double UniversalEquation::computeNurbMatter(int vertexIndex) const {
     return result;
 }
 
-long double UniversalEquation::computeNurbEnergy(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeNurbEnergy(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double result = getNurbEnergyStrength() * vertexWaveAmplitudes_[vertexIndex] * 0.3L;
+    Accum result = getNurbEnergyStrength() * vertexWaveAmplitudes_[vertexIndex] * Accum(0.3L);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed NURB energy for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, result);
@@ -697,9 +1221,10 @@ long double UniversalEquation::computeNurbEnergy(int vertexIndex) const {
     return result;
 }
 
-long double UniversalEquation::computeSpinEnergy(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeSpinEnergy(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double result = getSpinInteraction() * vertexSpins_[vertexIndex] * 0.2L;
+    Accum result = getSpinInteraction() * vertexSpins_[vertexIndex] * Accum(0.2L);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed spin energy for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, result);
@@ -707,9 +1232,10 @@ long double UniversalEquation::computeSpinEnergy(int vertexIndex) const {
     return result;
 }
 
-long double UniversalEquation::computeEMField(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeEMField(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double result = getEMFieldStrength() * vertexWaveAmplitudes_[vertexIndex] * 0.01L;
+    Accum result = getEMFieldStrength() * vertexWaveAmplitudes_[vertexIndex] * Accum(0.01L);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed EM field for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, result);
@@ -717,9 +1243,27 @@ long double UniversalEquation::computeEMField(int vertexIndex) const {
     return result;
 }
 
-long double UniversalEquation::computeGodWave(int vertexIndex) const {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::computeEMFieldMesh(UE::VertexStore<Accum>& field, std::vector<Accum>& potential) {
+    const auto params = getParams();
+    const uint64_t numVertices = nCubeVertices_.size();
+    if (vertexWaveAmplitudes_.size() != numVertices) {
+        LOG_ERROR_CAT("Simulation", "Vector size mismatch: nCubeVertices_={}, vertexWaveAmplitudes_={}",
+                      std::source_location::current(), numVertices, vertexWaveAmplitudes_.size());
+        throw std::runtime_error("Vector size mismatch in computeEMFieldMesh");
+    }
+    field.detach();
+    // Like charges repel, hence the negative coupling
+    particleMesh_.solve(nCubeVertices_, getCurrentDimension(), params->meshGridSize, vertexWaveAmplitudes_.vector(),
+                        -params->emFieldStrength * Accum(0.01L), field, &potential);
+    LOG_DEBUG_CAT("Simulation", "Computed mesh EM field: vertices={}, grid={}, cellSize={}",
+                  std::source_location::current(), numVertices, particleMesh_.gridSize(), particleMesh_.cellSize());
+}
+
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeGodWave(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    long double result = getGodWaveFreq() * vertexWaveAmplitudes_[vertexIndex] * 0.1L;
+    Accum result = getGodWaveFreq() * vertexWaveAmplitudes_[vertexIndex] * Accum(0.1L);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed God wave for vertex {}: result={}",
                       std::source_location::current(), vertexIndex, result);
@@ -727,9 +1271,10 @@ long double UniversalEquation::computeGodWave(int vertexIndex) const {
     return result;
 }
 
-long double UniversalEquation::computeInteraction(int vertexIndex, long double distance) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeInteraction(int vertexIndex, Accum distance) const {
     validateVertexIndex(vertexIndex);
-    long double result = getInfluence() * safe_div(1.0L, distance + 1e-10L);
+    Accum result = getInfluence() * safe_div(Accum(1), distance + Accum(1e-10L));
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed interaction for vertex {}: distance={}, result={}",
                       std::source_location::current(), vertexIndex, distance, result);
@@ -737,41 +1282,44 @@ long double UniversalEquation::computeInteraction(int vertexIndex, long double d
     return result;
 }
 
-std::vector<long double> UniversalEquation::computeVectorPotential(int vertexIndex) const {
+template<typename Real, typename Accum>
+std::array<Real, 3> UniversalEquationT<Real, Accum>::computeVectorPotential(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    std::vector<long double> result(std::min(3, getCurrentDimension()), 0.0L);
-    for (int i = 0; i < std::min(3, getCurrentDimension()); ++i) {
+    std::array<Real, 3> result{};
+    const int dims = std::min({3, getCurrentDimension(), vertexMomenta_.dimensions()});
+    for (int i = 0; i < dims; ++i) {
         result[i] = vertexMomenta_[vertexIndex][i] * getWeak();
     }
     if (debug_.load()) {
-        LOG_DEBUG_CAT("Simulation", "Computed vector potential for vertex {}: result size={}",
-                      std::source_location::current(), vertexIndex, result.size());
+        LOG_DEBUG_CAT("Simulation", "Computed vector potential for vertex {}: components={}",
+                      std::source_location::current(), vertexIndex, dims);
     }
     return result;
 }
 
-long double UniversalEquation::computeGravitationalPotential(int vertexIndex, int otherIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeGravitationalPotential(int vertexIndex, int otherIndex) const {
     validateVertexIndex(vertexIndex);
     validateVertexIndex(otherIndex);
     if (vertexIndex == otherIndex) {
-        return 0.0L; // No self-interaction
+        return Accum(0); // No self-interaction
     }
-    long double distance = 0.0L;
-    const auto& v1 = nCubeVertices_[vertexIndex];
-    const auto& v2 = nCubeVertices_[otherIndex];
-    for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
-        long double diff = v1[j] - v2[j];
+    Accum distance = Accum(0);
+    const int d = std::min(getCurrentDimension(), nCubeVertices_.dimensions());
+    for (int j = 0; j < d; ++j) {
+        auto coords = nCubeVertices_.plane(j);
+        Accum diff = coords[vertexIndex] - coords[otherIndex];
         distance += diff * diff;
     }
     distance = std::sqrt(distance);
-    if (distance <= 0.0L || std::isnan(distance) || std::isinf(distance)) {
-        distance = 1e-10L;
+    if (distance <= Accum(0) || std::isnan(distance) || std::isinf(distance)) {
+        distance = Accum(1e-10L);
         if (debug_.load()) {
             LOG_WARNING_CAT("Simulation", "Invalid distance between vertices {} and {}, using default={}",
                             std::source_location::current(), vertexIndex, otherIndex, distance);
         }
     }
-    long double result = -getInfluence() * safe_div(1.0L, distance);
+    Accum result = -getInfluence() * safe_div(Accum(1), distance);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed gravitational potential for vertices {} and {}: result={}",
                       std::source_location::current(), vertexIndex, otherIndex, result);
@@ -779,28 +1327,30 @@ long double UniversalEquation::computeGravitationalPotential(int vertexIndex, in
     return result;
 }
 
-std::vector<long double> UniversalEquation::computeGravitationalAcceleration(int vertexIndex) const {
+template<typename Real, typename Accum>
+std::vector<Accum> UniversalEquationT<Real, Accum>::computeGravitationalAcceleration(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
-    std::vector<long double> acceleration(getCurrentDimension(), 0.0L);
+    std::vector<Accum> acceleration(getCurrentDimension(), Accum(0));
+    const size_t d = static_cast<size_t>(std::min(getCurrentDimension(), nCubeVertices_.dimensions()));
+    const auto v1 = nCubeVertices_[vertexIndex];
     for (size_t i = 0; i < nCubeVertices_.size(); ++i) {
         if (static_cast<int>(i) == vertexIndex) continue;
-        long double distance = 0.0L;
-        const auto& v1 = nCubeVertices_[vertexIndex];
-        const auto& v2 = nCubeVertices_[i];
-        for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
-            long double diff = v1[j] - v2[j];
+        Accum distance = Accum(0);
+        const auto v2 = nCubeVertices_[i];
+        for (size_t j = 0; j < d; ++j) {
+            Accum diff = v1[j] - v2[j];
             distance += diff * diff;
         }
         distance = std::sqrt(distance);
-        if (distance <= 0.0L || std::isnan(distance) || std::isinf(distance)) {
-            distance = 1e-10L;
+        if (distance <= Accum(0) || std::isnan(distance) || std::isinf(distance)) {
+            distance = Accum(1e-10L);
             if (debug_.load()) {
                 LOG_WARNING_CAT("Simulation", "Invalid distance for vertex {} and {}, using default={}",
                                 std::source_location::current(), vertexIndex, i, distance);
             }
         }
-        long double force = getInfluence() * safe_div(1.0L, distance * distance);
-        for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
+        Accum force = getInfluence() * safe_div(Accum(1), distance * distance);
+        for (size_t j = 0; j < d; ++j) {
             acceleration[j] += force * (v2[j] - v1[j]) / distance;
         }
     }
@@ -811,40 +1361,42 @@ std::vector<long double> UniversalEquation::computeGravitationalAcceleration(int
     return acceleration;
 }
 
-long double UniversalEquation::safeExp(long double x) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::safeExp(Accum x) const {
     if (std::isnan(x) || std::isinf(x)) {
         if (debug_.load()) {
             LOG_WARNING_CAT("Simulation", "Invalid input to safeExp: x={}", std::source_location::current(), x);
         }
-        return 0.0L;
+        return Accum(0);
     }
-    if (x > 100.0L) {
+    if (x > Accum(100)) {
         if (debug_.load()) {
             LOG_WARNING_CAT("Simulation", "Clamping large exponent in safeExp: x={}", std::source_location::current(), x);
         }
-        x = 100.0L;
+        x = Accum(100);
     }
-    long double result = std::exp(x);
+    Accum result = std::exp(x);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed safeExp: x={}, result={}", std::source_location::current(), x, result);
     }
     return result;
 }
 
-long double UniversalEquation::safe_div(long double a, long double b) const {
-    if (b == 0.0L || std::isnan(b) || std::isinf(b)) {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::safe_div(Accum a, Accum b) const {
+    if (b == Accum(0) || std::isnan(b) || std::isinf(b)) {
         if (debug_.load()) {
             LOG_WARNING_CAT("Simulation", "Invalid divisor in safe_div: a={}, b={}", std::source_location::current(), a, b);
         }
-        return 0.0L;
+        return Accum(0);
     }
-    long double result = a / b;
+    Accum result = a / b;
     if (std::isnan(result) || std::isinf(result)) {
         if (debug_.load()) {
             LOG_WARNING_CAT("Simulation", "Invalid result in safe_div: a={}, b={}, result={}",
                             std::source_location::current(), a, b, result);
         }
-        return 0.0L;
+        return Accum(0);
     }
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed safe_div: a={}, b={}, result={}",
@@ -853,7 +1405,8 @@ long double UniversalEquation::safe_div(long double a, long double b) const {
     return result;
 }
 
-void UniversalEquation::validateVertexIndex(int vertexIndex, const std::source_location& loc) const {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::validateVertexIndex(int vertexIndex, const std::source_location& loc) const {
     if (vertexIndex < 0 || static_cast<size_t>(vertexIndex) >= nCubeVertices_.size()) {
         LOG_ERROR_CAT("Simulation", "Invalid vertexIndex: vertexIndex={}, size={}",
                       loc, vertexIndex, nCubeVertices_.size());
@@ -861,200 +1414,336 @@ void UniversalEquation::validateVertexIndex(int vertexIndex, const std::source_l
     }
 }
 
-void UniversalEquation::setCurrentDimension(int dimension) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setCurrentDimension(int dimension) {
     currentDimension_.store(std::clamp(dimension, 1, maxDimensions_));
-    needsUpdate_.store(true);
+    markDirty(kDirtyStructure);
     LOG_DEBUG_CAT("Simulation", "Set currentDimension: value={}", std::source_location::current(), dimension);
 }
 
-void UniversalEquation::setMode(int mode) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setMode(int mode) {
     mode_.store(std::clamp(mode, 1, maxDimensions_));
-    needsUpdate_.store(true);
+    markDirty(kDirtyStructure);
     LOG_DEBUG_CAT("Simulation", "Set mode: value={}", std::source_location::current(), mode);
 }
 
-void UniversalEquation::setInfluence(long double value) {
-    influence_.store(std::clamp(value, 0.0L, 10.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set influence: value={}", std::source_location::current(), influence_.load());
+template<typename Real, typename Accum>
+std::shared_ptr<const UE::Params<Accum>> UniversalEquationT<Real, Accum>::getParams() const {
+    return params_.load(std::memory_order_acquire);
 }
 
-void UniversalEquation::setWeak(long double value) {
-    weak_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set weak: value={}", std::source_location::current(), weak_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::beginUpdate() {
+    std::lock_guard<std::mutex> lock(paramsMutex_);
+    if (updateDepth_++ == 0) {
+        pendingParams_ = *params_.load(std::memory_order_relaxed);
+        pendingDirty_ = kDirtyNone;
+    }
+    LOG_DEBUG_CAT("Simulation", "Began parameter update: depth={}", std::source_location::current(), updateDepth_);
 }
 
-void UniversalEquation::setCollapse(long double value) {
-    collapse_.store(std::clamp(value, 0.0L, 5.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set collapse: value={}", std::source_location::current(), collapse_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::commit() {
+    std::lock_guard<std::mutex> lock(paramsMutex_);
+    if (updateDepth_ == 0) {
+        LOG_ERROR_CAT("Simulation", "commit() called without a matching beginUpdate()", std::source_location::current());
+        throw std::runtime_error("commit() without matching beginUpdate()");
+    }
+    if (--updateDepth_ > 0) {
+        return;
+    }
+    params_.store(std::make_shared<const UE::Params<Accum>>(pendingParams_), std::memory_order_release);
+    markDirty(pendingDirty_);
+    LOG_DEBUG_CAT("Simulation", "Committed parameter update: dirty={}", std::source_location::current(), pendingDirty_);
+}
+
+template<typename Real, typename Accum>
+template<typename F>
+void UniversalEquationT<Real, Accum>::updateParams(F&& mutate, unsigned dirty) {
+    std::lock_guard<std::mutex> lock(paramsMutex_);
+    if (updateDepth_ > 0) {
+        mutate(pendingParams_);
+        pendingDirty_ |= dirty;
+        return;
+    }
+    UE::Params<Accum> next = *params_.load(std::memory_order_relaxed);
+    mutate(next);
+    params_.store(std::make_shared<const UE::Params<Accum>>(next), std::memory_order_release);
+    markDirty(dirty);
 }
 
-void UniversalEquation::setTwoD(long double value) {
-    twoD_.store(std::clamp(value, 0.0L, 5.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set twoD: value={}", std::source_location::current(), twoD_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setInfluence(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(10));
+    updateParams([clamped](UE::Params<Accum>& p) { p.influence = clamped; }, kDirtyStrength | kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set influence: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setThreeDInfluence(long double value) {
-    threeDInfluence_.store(std::clamp(value, 0.0L, 5.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set threeDInfluence: value={}", std::source_location::current(), threeDInfluence_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setWeak(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.weak = clamped; }, kDirtyVectorPotential);
+    LOG_DEBUG_CAT("Simulation", "Set weak: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setOneDPermeation(long double value) {
-    oneDPermeation_.store(std::clamp(value, 0.0L, 5.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set oneDPermeation: value={}", std::source_location::current(), oneDPermeation_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setCollapse(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(5));
+    updateParams([clamped](UE::Params<Accum>& p) { p.collapse = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set collapse: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setNurbMatterStrength(long double value) {
-    nurbMatterStrength_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set nurbMatterStrength: value={}", std::source_location::current(), nurbMatterStrength_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setTwoD(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(5));
+    updateParams([clamped](UE::Params<Accum>& p) { p.twoD = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set twoD: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setNurbEnergyStrength(long double value) {
-    nurbEnergyStrength_.store(std::clamp(value, 0.0L, 2.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set nurbEnergyStrength: value={}", std::source_location::current(), nurbEnergyStrength_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setThreeDInfluence(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(5));
+    updateParams([clamped](UE::Params<Accum>& p) { p.threeDInfluence = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set threeDInfluence: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setAlpha(long double value) {
-    alpha_.store(std::clamp(value, 0.01L, 10.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set alpha: value={}", std::source_location::current(), alpha_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setOneDPermeation(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(5));
+    updateParams([clamped](UE::Params<Accum>& p) { p.oneDPermeation = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set oneDPermeation: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setBeta(long double value) {
-    beta_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set beta: value={}", std::source_location::current(), beta_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setNurbMatterStrength(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.nurbMatterStrength = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set nurbMatterStrength: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setCarrollFactor(long double value) {
-    carrollFactor_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set carrollFactor: value={}", std::source_location::current(), carrollFactor_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setNurbEnergyStrength(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(2));
+    updateParams([clamped](UE::Params<Accum>& p) { p.nurbEnergyStrength = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set nurbEnergyStrength: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setMeanFieldApprox(long double value) {
-    meanFieldApprox_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set meanFieldApprox: value={}", std::source_location::current(), meanFieldApprox_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setAlpha(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0.01L), Accum(10));
+    updateParams([clamped](UE::Params<Accum>& p) { p.alpha = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set alpha: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setAsymCollapse(long double value) {
-    asymCollapse_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set asymCollapse: value={}", std::source_location::current(), asymCollapse_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setBeta(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.beta = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set beta: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setPerspectiveTrans(long double value) {
-    perspectiveTrans_.store(std::clamp(value, 0.0L, 10.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set perspectiveTrans: value={}", std::source_location::current(), perspectiveTrans_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setCarrollFactor(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.carrollFactor = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set carrollFactor: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setPerspectiveFocal(long double value) {
-    perspectiveFocal_.store(std::clamp(value, 1.0L, 20.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set perspectiveFocal: value={}", std::source_location::current(), perspectiveFocal_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setMeanFieldApprox(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.meanFieldApprox = clamped; }, kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set meanFieldApprox: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setSpinInteraction(long double value) {
-    spinInteraction_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set spinInteraction: value={}", std::source_location::current(), spinInteraction_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setAsymCollapse(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.asymCollapse = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set asymCollapse: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setEMFieldStrength(long double value) {
-    emFieldStrength_.store(std::clamp(value, 0.0L, 1.0e7L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set emFieldStrength: value={}", std::source_location::current(), emFieldStrength_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPerspectiveTrans(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(10));
+    updateParams([clamped](UE::Params<Accum>& p) { p.perspectiveTrans = clamped; }, kDirtyProjection);
+    LOG_DEBUG_CAT("Simulation", "Set perspectiveTrans: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setRenormFactor(long double value) {
-    renormFactor_.store(std::clamp(value, 0.1L, 10.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set renormFactor: value={}", std::source_location::current(), renormFactor_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPerspectiveFocal(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(1), Accum(20));
+    updateParams([clamped](UE::Params<Accum>& p) { p.perspectiveFocal = clamped; }, kDirtyProjection);
+    LOG_DEBUG_CAT("Simulation", "Set perspectiveFocal: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::setVacuumEnergy(long double value) {
-    vacuumEnergy_.store(std::clamp(value, 0.0L, 1.0L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set vacuumEnergy: value={}", std::source_location::current(), vacuumEnergy_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setSpinInteraction(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.spinInteraction = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set spinInteraction: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setEMFieldStrength(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1.0e7L));
+    updateParams([clamped](UE::Params<Accum>& p) { p.emFieldStrength = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set emFieldStrength: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setRenormFactor(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0.1L), Accum(10));
+    updateParams([clamped](UE::Params<Accum>& p) { p.renormFactor = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set renormFactor: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVacuumEnergy(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.vacuumEnergy = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set vacuumEnergy: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setGravitySolver(UE::GravitySolver solver) {
+    updateParams([solver](UE::Params<Accum>& p) { p.gravitySolver = solver; }, kDirtyNone);
+    LOG_DEBUG_CAT("Simulation", "Set gravitySolver: value={}", std::source_location::current(), static_cast<int>(solver));
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setOpeningAngle(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(2));
+    updateParams([clamped](UE::Params<Accum>& p) { p.openingAngle = clamped; }, kDirtyNone);
+    LOG_DEBUG_CAT("Simulation", "Set openingAngle: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setMeshGridSize(int cells) {
+    const int rounded = UE::ParticleMeshSolver<Real, Accum>::roundGridSize(cells);
+    updateParams([rounded](UE::Params<Accum>& p) { p.meshGridSize = rounded; }, kDirtyNone);
+    LOG_DEBUG_CAT("Simulation", "Set meshGridSize: value={}", std::source_location::current(), rounded);
 }
 
-void UniversalEquation::setDebug(bool value) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setIntegrator(UE::Integrator integrator) {
+    updateParams([integrator](UE::Params<Accum>& p) { p.integrator = integrator; }, kDirtyNone);
+    LOG_DEBUG_CAT("Simulation", "Set integrator: value={}", std::source_location::current(), static_cast<int>(integrator));
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPotentialTargetError(Accum value) {
+    const Accum clamped = std::clamp(value, Accum(0), Accum(1));
+    updateParams([clamped](UE::Params<Accum>& p) { p.potentialTargetError = clamped; }, kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set potentialTargetError: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPotentialStrata(int value) {
+    const int clamped = std::clamp(value, 1, static_cast<int>(kMaxEnergyStrata));
+    updateParams([clamped](UE::Params<Accum>& p) { p.potentialStrata = clamped; }, kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set potentialStrata: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPotentialMaxRounds(int value) {
+    const int clamped = std::clamp(value, 2, 1024);
+    updateParams([clamped](UE::Params<Accum>& p) { p.potentialMaxRounds = clamped; }, kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set potentialMaxRounds: value={}", std::source_location::current(), clamped);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setPotentialSeed(uint64_t seed) {
+    updateParams([seed](UE::Params<Accum>& p) { p.potentialSeed = seed; }, kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Set potentialSeed: value={}", std::source_location::current(), seed);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setDebug(bool value) {
     debug_.store(value);
     LOG_DEBUG_CAT("Simulation", "Set debug: value={}", std::source_location::current(), value);
 }
 
-void UniversalEquation::setCurrentVertices(uint64_t value) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setCurrentVertices(uint64_t value) {
     currentVertices_.store(std::min(value, maxVertices_));
-    needsUpdate_.store(true);
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set currentVertices: value={}", std::source_location::current(), value);
 }
 
-void UniversalEquation::setNavigator(DimensionalNavigator* nav) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setNavigator(DimensionalNavigator* nav) {
     navigator_ = nav;
-    needsUpdate_.store(true);
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set navigator: value={}", std::source_location::current(), static_cast<void*>(nav));
 }
 
-void UniversalEquation::setNCubeVertex(int vertexIndex, const std::vector<long double>& vertex) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setNCubeVertex(int vertexIndex, const std::vector<Real>& vertex) {
     validateVertexIndex(vertexIndex);
     if (vertex.size() != static_cast<size_t>(getCurrentDimension())) {
         LOG_ERROR_CAT("Simulation", "Vertex dimension mismatch: vertexIndex={}, expected size={}, actual size={}",
                       std::source_location::current(), vertexIndex, getCurrentDimension(), vertex.size());
         throw std::invalid_argument("Vertex dimension mismatch");
     }
-    nCubeVertices_[vertexIndex] = vertex;
-    needsUpdate_.store(true);
+    // Keep the centroid sums current so only the moved vertex needs its projection refreshed
+    const size_t index = static_cast<size_t>(vertexIndex);
+    for (size_t j = 0; j < centroidSum_.size() && j < vertex.size(); ++j) {
+        centroidSum_[j] += static_cast<Accum>(vertex[j]) - static_cast<Accum>(nCubeVertices_.plane(static_cast<int>(j))[index]);
+    }
+    nCubeVertices_.setVertex(index, vertex);
+    markVertexDirty(index, kDirtyGeometry | kDirtyEnergySums);
     LOG_DEBUG_CAT("Simulation", "Set nCubeVertex for index {}: vertex size={}",
                   std::source_location::current(), vertexIndex, vertex.size());
 }
 
-void UniversalEquation::setVertexMomentum(int vertexIndex, const std::vector<long double>& momentum) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexMomentum(int vertexIndex, const std::vector<Real>& momentum) {
     validateVertexIndex(vertexIndex);
     if (momentum.size() != static_cast<size_t>(getCurrentDimension())) {
         LOG_ERROR_CAT("Simulation", "Momentum dimension mismatch: vertexIndex={}, expected size={}, actual size={}",
                       std::source_location::current(), vertexIndex, getCurrentDimension(), momentum.size());
         throw std::invalid_argument("Momentum dimension mismatch");
     }
-    vertexMomenta_[vertexIndex] = momentum;
-    needsUpdate_.store(true);
+    vertexMomenta_.setVertex(static_cast<size_t>(vertexIndex), momentum);
+    markVertexDirty(static_cast<size_t>(vertexIndex), kDirtyVectorPotential | kDirtyEnergySums);
     LOG_DEBUG_CAT("Simulation", "Set vertexMomentum for index {}: momentum size={}",
                   std::source_location::current(), vertexIndex, momentum.size());
 }
 
-void UniversalEquation::setVertexSpin(int vertexIndex, long double spin) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexSpin(int vertexIndex, Real spin) {
     validateVertexIndex(vertexIndex);
-    vertexSpins_[vertexIndex] = spin;
-    needsUpdate_.store(true);
+    // Running totals let compute() skip the vertex pass when only spins, amplitudes or their scales changed
+    energySums_.spin += static_cast<Accum>(spin) - static_cast<Accum>(vertexSpins_[vertexIndex]);
+    vertexSpins_.mutate()[vertexIndex] = spin;
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set vertexSpin for index {}: spin={}",
                   std::source_location::current(), vertexIndex, spin);
 }
 
-void UniversalEquation::setVertexWaveAmplitude(int vertexIndex, long double amplitude) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexWaveAmplitude(int vertexIndex, Real amplitude) {
     validateVertexIndex(vertexIndex);
-    vertexWaveAmplitudes_[vertexIndex] = amplitude;
-    needsUpdate_.store(true);
+    energySums_.amplitude += static_cast<Accum>(amplitude) - static_cast<Accum>(vertexWaveAmplitudes_[vertexIndex]);
+    vertexWaveAmplitudes_.mutate()[vertexIndex] = amplitude;
+    markVertexDirty(static_cast<size_t>(vertexIndex), kDirtyGodWave);
     LOG_DEBUG_CAT("Simulation", "Set vertexWaveAmplitude for index {}: amplitude={}",
                   std::source_location::current(), vertexIndex, amplitude);
 }
 
-void UniversalEquation::setProjectedVertex(int vertexIndex, const glm::vec3& vertex) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setProjectedVertex(int vertexIndex, const glm::vec3& vertex) {
     validateVertexIndex(vertexIndex);
-    projectedVerts_[vertexIndex] = vertex;
-    needsUpdate_.store(true);
+    projectedVerts_.mutate()[vertexIndex] = vertex;
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set projectedVertex for index {}: vertex=({},{},{})",
                   std::source_location::current(), vertexIndex, vertex.x, vertex.y, vertex.z);
 }
 
-void UniversalEquation::setNCubeVertices(const std::vector<std::vector<long double>>& vertices) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setNCubeVertices(const std::vector<std::vector<Real>>& vertices) {
     for (size_t i = 0; i < vertices.size(); ++i) {
         if (vertices[i].size() != static_cast<size_t>(getCurrentDimension())) {
             LOG_ERROR_CAT("Simulation", "Vertex dimension mismatch at index {}: expected size={}, actual size={}",
@@ -1062,12 +1751,13 @@ void UniversalEquation::setNCubeVertices(const std::vector<std::vector<long doub
             throw std::invalid_argument("Vertex dimension mismatch");
         }
     }
-    nCubeVertices_ = vertices;
-    needsUpdate_.store(true);
+    nCubeVertices_ = UE::VertexStore<Real>::fromNested(vertices, getCurrentDimension(), vertexStorage_);
+    markDirty(kDirtyStructure);
     LOG_DEBUG_CAT("Simulation", "Set nCubeVertices: size={}", std::source_location::current(), vertices.size());
 }
 
-void UniversalEquation::setVertexMomenta(const std::vector<std::vector<long double>>& momenta) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexMomenta(const std::vector<std::vector<Real>>& momenta) {
     for (size_t i = 0; i < momenta.size(); ++i) {
         if (momenta[i].size() != static_cast<size_t>(getCurrentDimension())) {
             LOG_ERROR_CAT("Simulation", "Momentum dimension mismatch at index {}: expected size={}, actual size={}",
@@ -1075,129 +1765,365 @@ void UniversalEquation::setVertexMomenta(const std::vector<std::vector<long doub
             throw std::invalid_argument("Momentum dimension mismatch");
         }
     }
-    vertexMomenta_ = momenta;
-    needsUpdate_.store(true);
+    vertexMomenta_ = UE::VertexStore<Real>::fromNested(momenta, getCurrentDimension(), vertexStorage_);
+    markDirty(kDirtyVectorPotential | kDirtyEnergySums);
     LOG_DEBUG_CAT("Simulation", "Set vertexMomenta: size={}", std::source_location::current(), momenta.size());
 }
 
-void UniversalEquation::setVertexSpins(const std::vector<long double>& spins) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexSpins(const std::vector<Real>& spins) {
     vertexSpins_ = spins;
-    needsUpdate_.store(true);
+    energySums_.spin = UE::reproducibleSum<Accum>(std::span<const Real>(vertexSpins_.vector()), reductionPartials_);
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set vertexSpins: size={}", std::source_location::current(), spins.size());
 }
 
-void UniversalEquation::setVertexWaveAmplitudes(const std::vector<long double>& amplitudes) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setVertexWaveAmplitudes(const std::vector<Real>& amplitudes) {
     vertexWaveAmplitudes_ = amplitudes;
-    needsUpdate_.store(true);
+    energySums_.amplitude = UE::reproducibleSum<Accum>(std::span<const Real>(vertexWaveAmplitudes_.vector()), reductionPartials_);
+    markDirty(kDirtyGodWave);
     LOG_DEBUG_CAT("Simulation", "Set vertexWaveAmplitudes: size={}", std::source_location::current(), amplitudes.size());
 }
 
-void UniversalEquation::setProjectedVertices(const std::vector<glm::vec3>& vertices) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setProjectedVertices(const std::vector<glm::vec3>& vertices) {
     projectedVerts_ = vertices;
-    needsUpdate_.store(true);
+    markDirty(kDirtyEnergy);
     LOG_DEBUG_CAT("Simulation", "Set projectedVertices: size={}", std::source_location::current(), vertices.size());
     validateProjectedVertices();
 }
 
-void UniversalEquation::setTotalCharge(long double value) {
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setTotalCharge(Accum value) {
     totalCharge_.store(value);
     LOG_DEBUG_CAT("Simulation", "Set totalCharge: value={}", std::source_location::current(), value);
 }
 
-void UniversalEquation::setMaterialDensity(long double density) {
-    materialDensity_.store(std::clamp(density, 0.0L, 1.0e6L));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Set materialDensity: value={}", std::source_location::current(), materialDensity_.load());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::setMaterialDensity(Accum density) {
+    const Accum clamped = std::clamp(density, Accum(0), Accum(1.0e6L));
+    updateParams([clamped](UE::Params<Accum>& p) { p.materialDensity = clamped; }, kDirtyEnergy);
+    LOG_DEBUG_CAT("Simulation", "Set materialDensity: value={}", std::source_location::current(), clamped);
 }
 
-void UniversalEquation::evolveTimeStep(long double dt) {
-    LOG_INFO_CAT("Simulation", "Evolving time step: dt={}", std::source_location::current(), dt);
-    for (size_t i = 0; i < nCubeVertices_.size(); ++i) {
-        validateVertexIndex(static_cast<int>(i));
-        for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
-            nCubeVertices_[i][j] += vertexMomenta_[i][j] * dt;
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::evolveTimeStep(Accum dt) {
+    detachVertexState();
+    #pragma omp parallel
+    driftTeam(dt);
+    simulationTime_.fetch_add(static_cast<float>(dt));
+    markDirty(kDirtyGeometry | kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Time step evolved: dt={}, simulationTime={}", std::source_location::current(),
+                  dt, simulationTime_.load());
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::updateMomentum() {
+    const auto params = getParams();
+    const int d = gravityDimensions(*params);
+    detachVertexState();
+    #pragma omp parallel
+    {
+        computeAccelerationsTeam(*params, d, accelerations_);
+        kickTeam(Accum(0.01L));
+    }
+    markDirty(kDirtyVectorPotential | kDirtyEnergySums);
+    LOG_DEBUG_CAT("Simulation", "Momentum updated for {} vertices", std::source_location::current(), nCubeVertices_.size());
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::computeAccelerations(UE::VertexStore<Accum>& out) {
+    const auto params = getParams();
+    const int d = gravityDimensions(*params);
+    out.detach();
+    #pragma omp parallel
+    computeAccelerationsTeam(*params, d, out);
+    if (debug_.load() && params->gravitySolver == UE::GravitySolver::BarnesHut) {
+        LOG_DEBUG_CAT("Simulation", "Barnes-Hut accelerations: nodes={}, openingAngle={}",
+                      std::source_location::current(), barnesHut_.nodeCount(), params->openingAngle);
+    }
+}
+
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::gravityDimensions(const UE::Params<Accum>& params) const {
+    if (params.gravitySolver == UE::GravitySolver::BarnesHut && params.meanFieldApprox < Accum(1)) {
+        UE::BarnesHutTree<Real, Accum>::checkCapacity(nCubeVertices_.size());
+    }
+    return std::min(getCurrentDimension(), nCubeVertices_.dimensions());
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::computeAccelerationsTeam(const UE::Params<Accum>& params, int dimensions,
+                                                               UE::VertexStore<Accum>& out) {
+    // meanFieldApprox blends the O(N) mean field into the selected solver; at 1 the solver is skipped
+    const Accum weight = params.meanFieldApprox;
+    if (weight < Accum(1)) {
+        if (params.gravitySolver == UE::GravitySolver::BarnesHut) {
+            barnesHut_.buildTeam(nCubeVertices_, dimensions);
+            barnesHut_.computeAccelerationsTeam(nCubeVertices_, params.influence, params.openingAngle, out);
+        } else if (params.gravitySolver == UE::GravitySolver::ParticleMesh) {
+            particleMesh_.solveTeam(nCubeVertices_, dimensions, params.meshGridSize, {}, params.influence, out);
+        } else {
+            pairwiseGravity_.computeTeam(nCubeVertices_, dimensions, params.influence, out);
         }
     }
-    simulationTime_.fetch_add(static_cast<float>(dt));
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Time step evolved: simulationTime={}", std::source_location::current(), simulationTime_.load());
+    if (weight > Accum(0)) {
+        meanField_.fitTeam(nCubeVertices_, dimensions);
+        meanField_.blendAccelerationsTeam(nCubeVertices_, params.influence, weight, out);
+    }
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::detachVertexState() {
+    nCubeVertices_.detach();
+    vertexMomenta_.detach();
+    accelerations_.detach();
 }
 
-void UniversalEquation::updateMomentum() {
-    LOG_INFO_CAT("Simulation", "Updating momentum for {} vertices", std::source_location::current(), nCubeVertices_.size());
-    for (size_t i = 0; i < vertexMomenta_.size(); ++i) {
-        validateVertexIndex(static_cast<int>(i));
-        auto acc = computeGravitationalAcceleration(static_cast<int>(i));
-        for (size_t j = 0; j < static_cast<size_t>(getCurrentDimension()); ++j) {
-            vertexMomenta_[i][j] += acc[j] * 0.01L;
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::kickTeam(Accum scale) {
+    const int d = std::min(accelerations_.dimensions(), vertexMomenta_.dimensions());
+    const size_t count = std::min(accelerations_.size(), vertexMomenta_.size());
+    for (int j = 0; j < d; ++j) {
+        Real* momenta = vertexMomenta_.plane(j).data();
+        const Accum* acc = accelerations_.plane(j).data();
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < count; ++i) {
+            momenta[i] += acc[i] * scale;
+        }
+    }
+    #pragma omp barrier
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::driftTeam(Accum dt) {
+    const int d = std::min({getCurrentDimension(), nCubeVertices_.dimensions(), vertexMomenta_.dimensions(),
+                            static_cast<int>(driftPartials_.size() / kCentroidBlocks)});
+    const size_t count = std::min(nCubeVertices_.size(), vertexMomenta_.size());
+    const size_t blockSize = (count + kCentroidBlocks - 1) / kCentroidBlocks;
+    // Momentum sums per fixed block give the centroid shift without another pass over the positions
+    for (int j = 0; j < d; ++j) {
+        Real* coords = nCubeVertices_.plane(j).data();
+        const Real* momenta = vertexMomenta_.plane(j).data();
+        Accum* partials = driftPartials_.data() + static_cast<size_t>(j) * kCentroidBlocks;
+        #pragma omp for schedule(static) nowait
+        for (size_t b = 0; b < kCentroidBlocks; ++b) {
+            const size_t begin = std::min(count, b * blockSize);
+            const size_t end = std::min(count, begin + blockSize);
+            Accum sum = Accum(0);
+            for (size_t i = begin; i < end; ++i) {
+                coords[i] += momenta[i] * dt;
+                sum += momenta[i];
+            }
+            partials[b] = sum;
+        }
+    }
+    #pragma omp barrier
+    #pragma omp single
+    {
+        const size_t tracked = std::min(centroidSum_.size(), static_cast<size_t>(d));
+        for (size_t j = 0; j < tracked; ++j) {
+            const Accum* partials = driftPartials_.data() + j * kCentroidBlocks;
+            Accum sum = Accum(0);
+            for (size_t b = 0; b < kCentroidBlocks; ++b) {
+                sum += partials[b];
+            }
+            centroidSum_[j] += sum * dt;
         }
     }
-    needsUpdate_.store(true);
-    LOG_DEBUG_CAT("Simulation", "Momentum updated", std::source_location::current());
 }
 
-void UniversalEquation::advanceCycle() {
-    LOG_INFO_CAT("Simulation", "Advancing simulation cycle", std::source_location::current());
-    updateMomentum();
-    evolveTimeStep(0.01L);
-    LOG_DEBUG_CAT("Simulation", "Simulation cycle advanced", std::source_location::current());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::advanceCycle() {
+    advance(1, Accum(0.01L));
 }
 
-std::vector<UE::DimensionData> UniversalEquation::computeBatch(int startDim, int endDim) {
-    LOG_INFO_CAT("Simulation", "Starting batch computation from dimension {} to {}",
-                 std::source_location::current(), startDim, endDim);
-    std::vector<UE::DimensionData> results;
-    int originalDim = getCurrentDimension();
-    for (int dim = startDim; dim <= endDim && dim <= maxDimensions_; ++dim) {
-        setCurrentDimension(dim);
-        initializeWithRetry();
-        UE::EnergyResult result = compute();
-        UE::DimensionData data;
-        data.dimension = dim;
-        data.scale = 1.0L; // Set default scale
-        data.observable = result.observable;
-        data.potential = result.potential;
-        data.nurbMatter = result.nurbMatter;
-        data.nurbEnergy = result.nurbEnergy;
-        data.spinEnergy = result.spinEnergy;
-        data.momentumEnergy = result.momentumEnergy;
-        data.fieldEnergy = result.fieldEnergy;
-        data.GodWaveEnergy = result.GodWaveEnergy;
-        results.push_back(data);
-        if (debug_.load()) {
-            LOG_DEBUG_CAT("Simulation", "Computed dimension {}: {}", std::source_location::current(), dim, data.toString());
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::advance(int steps, Accum dt) {
+    if (steps <= 0) {
+        return;
+    }
+    if (std::isnan(dt) || std::isinf(dt)) {
+        LOG_ERROR_CAT("Simulation", "Invalid time step for advance: dt={}", std::source_location::current(), dt);
+        throw std::invalid_argument("Time step must be finite");
+    }
+    integrate(steps, dt, 0, Accum(0));
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::advance(Accum totalTime, Accum dt, int substeps) {
+    if (std::isnan(totalTime) || std::isinf(totalTime) || totalTime < Accum(0) ||
+        std::isnan(dt) || std::isinf(dt) || dt <= Accum(0) || substeps <= 0) {
+        LOG_ERROR_CAT("Simulation", "Invalid advance arguments: totalTime={}, dt={}, substeps={}",
+                      std::source_location::current(), totalTime, dt, substeps);
+        throw std::invalid_argument("advance requires totalTime >= 0, dt > 0 and substeps > 0");
+    }
+    const Accum outer = std::floor(totalTime / dt);
+    const Accum remainder = totalTime - outer * dt;
+    const Accum h = dt / static_cast<Accum>(substeps);
+    const std::int64_t steps = static_cast<std::int64_t>(outer) * substeps;
+    // Remainders below a rounding-level fraction of dt are dropped instead of taking a degenerate step
+    const bool tail = remainder > dt * Accum(1e-9L);
+    integrate(steps, h, tail ? substeps : 0, tail ? remainder / static_cast<Accum>(substeps) : Accum(0));
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::integrate(std::int64_t steps, Accum h, std::int64_t tailSteps, Accum tailH) {
+    steps = std::max<std::int64_t>(steps, 0);
+    tailSteps = std::max<std::int64_t>(tailSteps, 0);
+    if (steps == 0 && tailSteps == 0) {
+        return;
+    }
+    const auto params = getParams();
+    const int d = gravityDimensions(*params);
+    const auto integrator = params->integrator;
+    detachVertexState();
+    const auto run = [&](std::int64_t mainSteps, std::int64_t lastSteps, bool accelerationsCurrent) {
+        switch (integrator) {
+            case UE::Integrator::Leapfrog:
+                integrateWith<UE::Integrator::Leapfrog>(*params, d, mainSteps, h, lastSteps, tailH,
+                                                        accelerationsCurrent);
+                break;
+            case UE::Integrator::Yoshida4:
+                integrateWith<UE::Integrator::Yoshida4>(*params, d, mainSteps, h, lastSteps, tailH,
+                                                        accelerationsCurrent);
+                break;
+            case UE::Integrator::Euler:
+            default:
+                integrateWith<UE::Integrator::Euler>(*params, d, mainSteps, h, lastSteps, tailH, accelerationsCurrent);
+                break;
+        }
+        const Accum elapsed = h * static_cast<Accum>(mainSteps) + tailH * static_cast<Accum>(lastSteps);
+        simulationTime_.fetch_add(static_cast<float>(elapsed));
+        markDirty(kDirtyGeometry | kDirtyVectorPotential | kDirtyEnergySums);
+    };
+    if (!trajectory_) {
+        run(steps, tailSteps, false);
+    } else {
+        // One parallel region per recorded interval; recording itself only reads the state
+        const std::int64_t interval = trajectory_->options().stepInterval;
+        for (std::int64_t done = 0; done < steps + tailSteps;) {
+            const std::int64_t segment = std::min<std::int64_t>(
+                steps + tailSteps - done, interval - static_cast<std::int64_t>(trajectoryStep_ % interval));
+            const std::int64_t mainSteps = std::clamp<std::int64_t>(steps - done, 0, segment);
+            run(mainSteps, segment - mainSteps, done > 0);
+            done += segment;
+            trajectoryStep_ += static_cast<uint64_t>(segment);
+            if (trajectoryStep_ % interval == 0) {
+                recordTrajectoryStep();
+            }
+        }
+    }
+    LOG_DEBUG_CAT("Simulation", "Integrated {} steps of {} and {} of {} with integrator {}: simulationTime={}",
+                  std::source_location::current(), steps, h, tailSteps, tailH, static_cast<int>(integrator),
+                  simulationTime_.load());
+}
+
+template<typename Real, typename Accum>
+template<UE::Integrator I>
+void UniversalEquationT<Real, Accum>::integrateWith(const UE::Params<Accum>& params, int dimensions, std::int64_t steps,
+                                                    Accum h, std::int64_t tailSteps, Accum tailH,
+                                                    bool accelerationsCurrent) {
+    #pragma omp parallel
+    {
+        // First-same-as-last schemes carry the closing force evaluation into the next step
+        if constexpr (UE::IntegratorTraits<I>::firstSameAsLast) {
+            if (!accelerationsCurrent) {
+                computeAccelerationsTeam(params, dimensions, accelerations_);
+            }
+        }
+        for (std::int64_t step = 0; step < steps; ++step) {
+            stepTeam<I>(params, dimensions, h);
+        }
+        for (std::int64_t step = 0; step < tailSteps; ++step) {
+            stepTeam<I>(params, dimensions, tailH);
         }
     }
-    setCurrentDimension(originalDim);
-    initializeWithRetry();
-    LOG_INFO_CAT("Simulation", "Batch computation completed: results size={}", std::source_location::current(), results.size());
-    return results;
 }
 
-void UniversalEquation::exportToCSV(const std::string& filename, const std::vector<UE::DimensionData>& data) const {
-    LOG_INFO_CAT("Simulation", "Exporting to CSV: filename={}", std::source_location::current(), filename);
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        LOG_ERROR_CAT("Simulation", "Failed to open file for CSV export: {}", std::source_location::current(), filename);
-        throw std::runtime_error("Failed to open CSV file");
+template<typename Real, typename Accum>
+std::shared_ptr<UE::TrajectoryWriter> UniversalEquationT<Real, Accum>::recordTrajectory(
+    const std::string& path, const UE::TrajectoryOptions& options) {
+    LOG_INFO_CAT("Simulation", "Recording trajectory: path={}, stepInterval={}, frameInterval={}, compression={}",
+                 std::source_location::current(), path, options.stepInterval, options.frameInterval,
+                 static_cast<uint32_t>(options.compression));
+    if (trajectory_) {
+        stopTrajectory();
+    }
+    trajectory_ = std::make_shared<UE::TrajectoryWriter>(path, nCubeVertices_.size(), nCubeVertices_.dimensions(),
+                                                         nCubeVertices_.stride(), static_cast<uint32_t>(sizeof(Real)),
+                                                         options);
+    trajectoryStep_ = 0;
+    recordTrajectoryStep();
+    return trajectory_;
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::stopTrajectory() {
+    if (!trajectory_) {
+        return;
     }
-    file << "Dimension,Scale,Observable,Potential,NURB_Matter,NURB_Energy,Spin_Energy,Momentum_Energy,Field_Energy,God_Wave_Energy\n";
-    for (const auto& d : data) {
-        file << std::fixed << std::setprecision(10)
-             << d.dimension << "," << d.scale << "," << d.observable << "," << d.potential << ","
-             << d.nurbMatter << "," << d.nurbEnergy << "," << d.spinEnergy << ","
-             << d.momentumEnergy << "," << d.fieldEnergy << "," << d.GodWaveEnergy << "\n";
+    // Detached first, so a writer error does not leave a failed recording attached
+    const std::shared_ptr<UE::TrajectoryWriter> writer = std::exchange(trajectory_, nullptr);
+    try {
+        writer->close();
+        LOG_INFO_CAT("Simulation", "Trajectory closed: path={}, rows={}", std::source_location::current(),
+                     writer->path(), writer->rowsAppended());
+    } catch (const std::exception& e) {
+        LOG_ERROR_CAT("Simulation", "Trajectory writer failed: path={}, error={}", std::source_location::current(),
+                      writer->path(), e.what());
+        throw;
     }
-    file.close();
-    LOG_DEBUG_CAT("Simulation", "CSV export completed", std::source_location::current());
 }
 
-UE::DimensionData UniversalEquation::updateCache() {
-    LOG_INFO_CAT("Simulation", "Updating cache", std::source_location::current());
-    UE::EnergyResult result = compute();
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::recordTrajectoryStep() {
+    const UE::EnergyResult energy = compute();
+    const UE::TrajectoryRow row{
+        trajectoryStep_, static_cast<double>(getSimulationTime()), static_cast<double>(energy.observable),
+        static_cast<double>(energy.potential), static_cast<double>(energy.nurbMatter),
+        static_cast<double>(energy.nurbEnergy), static_cast<double>(energy.spinEnergy),
+        static_cast<double>(energy.momentumEnergy), static_cast<double>(energy.fieldEnergy),
+        static_cast<double>(energy.GodWaveEnergy), static_cast<double>(energy.potentialError),
+        energy.potentialRounds};
+    std::span<const std::byte> frame;
+    if (trajectory_->frameDue()) {
+        if (nCubeVertices_.size() == trajectory_->vertexCount() &&
+            nCubeVertices_.dimensions() == trajectory_->dimensions()) {
+            frame = std::as_bytes(std::as_const(nCubeVertices_).planes());
+        } else {
+            LOG_ERROR_CAT("Simulation", "Vertex layout changed while recording: vertices={}, dimensions={}",
+                          std::source_location::current(), nCubeVertices_.size(), nCubeVertices_.dimensions());
+            throw std::runtime_error("Vertex layout no longer matches the trajectory being recorded");
+        }
+    }
+    trajectory_->append(row, frame);
+}
+
+template<typename Real, typename Accum>
+template<UE::Integrator I>
+void UniversalEquationT<Real, Accum>::stepTeam(const UE::Params<Accum>& params, int dimensions, Accum h) {
+    if constexpr (I == UE::Integrator::Euler) {
+        computeAccelerationsTeam(params, dimensions, accelerations_);
+        kickTeam(h);
+        driftTeam(h);
+    } else {
+        for (long double weight : UE::IntegratorTraits<I>::weights) {
+            const Accum w = static_cast<Accum>(weight) * h;
+            kickTeam(w * Accum(0.5L));
+            driftTeam(w);
+            computeAccelerationsTeam(params, dimensions, accelerations_);
+            kickTeam(w * Accum(0.5L));
+        }
+    }
+}
+
+template<typename Real, typename Accum>
+UE::DimensionData UniversalEquationT<Real, Accum>::toDimensionData(int dimension, const UE::EnergyResult& result) {
     UE::DimensionData data;
-    data.dimension = getCurrentDimension();
-    data.scale = 1.0L; // Set default scale
+    data.dimension = dimension;
+    data.scale = Accum(1); // Set default scale
     data.observable = result.observable;
     data.potential = result.potential;
     data.nurbMatter = result.nurbMatter;
@@ -1206,6 +2132,302 @@ UE::DimensionData UniversalEquation::updateCache() {
     data.momentumEnergy = result.momentumEnergy;
     data.fieldEnergy = result.fieldEnergy;
     data.GodWaveEnergy = result.GodWaveEnergy;
+    return data;
+}
+
+template<typename Real, typename Accum>
+std::vector<UE::DimensionData> UniversalEquationT<Real, Accum>::computeBatch(int startDim, int endDim) const {
+    std::vector<UE::DimensionData> results;
+    computeBatch(startDim, endDim, [&results](const UE::DimensionData& data) { results.push_back(data); });
+    std::sort(results.begin(), results.end(),
+              [](const UE::DimensionData& a, const UE::DimensionData& b) { return a.dimension < b.dimension; });
+    return results;
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::computeBatch(int startDim, int endDim, const DimensionDataCallback& onResult) const {
+    const int first = std::max(1, startDim);
+    const int last = std::min(endDim, maxDimensions_);
+    LOG_INFO_CAT("Simulation", "Starting batch computation from dimension {} to {}",
+                 std::source_location::current(), first, last);
+    if (first > last) {
+        return;
+    }
+    const auto params = getParams();
+    const uint64_t count = getMaxVertices();
+
+    std::mutex resultMutex; // Serializes onResult and the first captured error
+    std::exception_ptr error;
+    std::atomic<int> completed{0};
+    #pragma omp parallel
+    #pragma omp single
+    {
+        // Largest dimensions are the most expensive, so they are queued first; each dimension task splits its
+        // reduction blocks into a taskloop that idle threads steal from.
+        for (int dim = last; dim >= first; --dim) {
+            #pragma omp task firstprivate(dim)
+            {
+                try {
+                    // The lattice is generated per vertex, so a task holds only its sampling scratch
+                    const UE::ProceduralVertices<Real, Accum> vertices(count, dim, params->oneDPermeation);
+                    UE::MeanFieldGravity<Real, Accum> meanField;
+                    if (params->meanFieldApprox > Accum(0)) {
+                        meanField.fit(vertices, dim);
+                    }
+                    EnergyScratch scratch;
+                    EnergyPass pass = prepareEnergyPass(vertices, dim, params->influence, params->potentialStrata,
+                                                        scratch, false, &meanField, params->meanFieldApprox);
+                    const EnergySums sums = runEnergyPass(pass, scratch, *params, [](const EnergyPass& round) {
+                        #pragma omp taskloop grainsize(1)
+                        for (size_t b = 0; b < round.blocks; ++b) {
+                            energyBlock(round, b);
+                        }
+                    });
+                    const UE::DimensionData data = toDimensionData(dim, energyFromSums(sums, pass.count, *params));
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    onResult(data);
+                    completed.fetch_add(1);
+                    if (debug_.load()) {
+                        LOG_DEBUG_CAT("Simulation", "Computed dimension {}: {}", std::source_location::current(), dim, data.toString());
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        }
+    }
+    if (error) {
+        LOG_ERROR_CAT("Simulation", "Batch computation failed after {} dimensions", std::source_location::current(),
+                      completed.load());
+        std::rethrow_exception(error);
+    }
+    LOG_INFO_CAT("Simulation", "Batch computation completed: dimensions={}", std::source_location::current(), completed.load());
+}
+
+template<typename Real, typename Accum>
+UE::SweepResults UniversalEquationT<Real, Accum>::sweep(std::span<const UE::Params<Accum>> points, int dimension) const {
+    const int dim = std::clamp(dimension, 1, maxDimensions_);
+    const uint64_t count = getMaxVertices();
+    LOG_INFO_CAT("Simulation", "Starting parameter sweep: points={}, dimension={}, vertices={}",
+                 std::source_location::current(), points.size(), dim, count);
+    UE::SweepResults results;
+    results.resize(points.size());
+    if (points.empty()) {
+        return results;
+    }
+
+    // One shared initial lattice. The potential is linear in influence and the amplitudes in oneDPermeation, so
+    // the lattice is reduced once with both set to 1 and each parameter set only rescales the sums.
+    const UE::ProceduralVertices<Real, Accum> vertices(count, dim, Accum(1));
+    // The estimator settings of the first point pick the samples; its relative error does not depend on influence.
+    // The sampled and mean-field potentials are reduced separately so every point can apply its own blend;
+    // refinement therefore stops on the sampled term alone.
+    EnergyScratch scratch;
+    EnergyPass pass = prepareEnergyPass(vertices, dim, Accum(1), points.front().potentialStrata, scratch, false,
+                                        nullptr, Accum(0));
+    const EnergySums unit = runEnergyPass(pass, scratch, points.front(), [](const EnergyPass& round) {
+        #pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < round.blocks; ++b) {
+            energyBlock(round, b);
+        }
+    });
+    Accum meanFieldUnit = Accum(0);
+    if (std::any_of(points.begin(), points.end(), [](const UE::Params<Accum>& p) { return p.meanFieldApprox > Accum(0); })) {
+        UE::MeanFieldGravity<Real, Accum> meanField;
+        meanField.fit(vertices, dim);
+        meanFieldUnit = meanField.totalPotential(vertices, Accum(1));
+    }
+
+    const size_t rows = points.size();
+    #pragma omp parallel for schedule(static)
+    for (size_t n = 0; n < rows; ++n) {
+        const UE::Params<Accum>& params = points[n];
+        const Accum weight = std::clamp(params.meanFieldApprox, Accum(0), Accum(1));
+        const Accum sampledScale = params.influence * (Accum(1) - weight);
+        const EnergySums sums{sampledScale * unit.potential + params.influence * weight * meanFieldUnit,
+                              params.oneDPermeation * unit.amplitude, unit.spin, unit.momentumSquared,
+                              sampledScale * sampledScale * unit.potentialVariance,
+                              weight < Accum(1) ? unit.potentialRounds : 1};
+        const UE::EnergyResult result = energyFromSums(sums, count, params);
+        results.dimension[n] = dim;
+        results.observable[n] = result.observable;
+        results.potential[n] = result.potential;
+        results.nurbMatter[n] = result.nurbMatter;
+        results.nurbEnergy[n] = result.nurbEnergy;
+        results.spinEnergy[n] = result.spinEnergy;
+        results.momentumEnergy[n] = result.momentumEnergy;
+        results.fieldEnergy[n] = result.fieldEnergy;
+        results.GodWaveEnergy[n] = result.GodWaveEnergy;
+        results.potentialError[n] = result.potentialError;
+    }
+    LOG_INFO_CAT("Simulation", "Parameter sweep completed: points={}", std::source_location::current(), rows);
+    return results;
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::exportToCSV(const std::string& filename, const std::vector<UE::DimensionData>& data) const {
+    exportResults(filename, std::span<const UE::DimensionData>(data));
+}
+
+template<typename Real, typename Accum>
+template<typename Write>
+void UniversalEquationT<Real, Accum>::exportRows(const std::string& path, std::vector<UE::ExportColumn> columns,
+                                                 const UE::ExportOptions& options, std::size_t rows, Write&& write) {
+    LOG_INFO_CAT("Simulation", "Exporting results: path={}, rows={}, format={}, append={}",
+                 std::source_location::current(), path, rows,
+                 options.format == UE::ExportFormat::Csv ? "csv" : "arrow", options.mode == UE::ExportMode::Append);
+    try {
+        UE::ResultWriter writer(path, std::move(columns), options);
+        write(writer);
+        writer.close();
+    } catch (const std::exception& e) {
+        LOG_ERROR_CAT("Simulation", "Export failed: path={}, error={}", std::source_location::current(), path, e.what());
+        throw;
+    }
+    LOG_DEBUG_CAT("Simulation", "Export completed: path={}", std::source_location::current(), path);
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::exportResults(const std::string& path, std::span<const UE::DimensionData> data,
+                                                    const UE::ExportOptions& options) const {
+    exportRows(path, UE::dimensionDataColumns(), options, data.size(), [&](UE::ResultWriter& writer) {
+        for (const auto& d : data) UE::writeRow(writer, d);
+    });
+}
+
+template<typename Real, typename Accum>
+void UniversalEquationT<Real, Accum>::exportResults(const std::string& path, const UE::SweepResults& results,
+                                                    const UE::ExportOptions& options) const {
+    exportRows(path, UE::energyResultColumns(), options, results.size(),
+               [&](UE::ResultWriter& writer) { UE::writeRows(writer, results); });
+}
+
+template<typename Real, typename Accum>
+std::future<void> UniversalEquationT<Real, Accum>::saveCheckpoint(const std::string& path,
+                                                                   const UE::CheckpointOptions& options) const {
+    const uint64_t count = nCubeVertices_.size();
+    LOG_INFO_CAT("Simulation", "Saving checkpoint: path={}, vertices={}, compression={}",
+                 std::source_location::current(), path, count, static_cast<uint32_t>(options.compression));
+    if (vertexMomenta_.size() != count || vertexSpins_.size() != count || vertexWaveAmplitudes_.size() != count) {
+        LOG_ERROR_CAT("Simulation", "Vector size mismatch: nCubeVertices_={}, vertexMomenta_={}, vertexSpins_={}, vertexWaveAmplitudes_={}",
+                      std::source_location::current(), count, vertexMomenta_.size(), vertexSpins_.size(),
+                      vertexWaveAmplitudes_.size());
+        throw std::runtime_error("Vector size mismatch in saveCheckpoint");
+    }
+    // Everything the writer reads is captured here, on the caller's thread; the arrays are shared copy-on-write,
+    // so later steps copy what they overwrite while the save is in flight
+    struct Snapshot {
+        UE::CheckpointHeader header;
+        UE::Params<Accum> params;
+        UE::VertexStore<Real> positions;
+        UE::VertexStore<Real> momenta;
+        UE::SharedVector<Real> spins;
+        UE::SharedVector<Real> amplitudes;
+    };
+    auto snapshot = std::make_shared<Snapshot>(Snapshot{
+        UE::CheckpointHeader{}, *getParams(), nCubeVertices_, vertexMomenta_, vertexSpins_, vertexWaveAmplitudes_});
+    UE::CheckpointHeader& header = snapshot->header;
+    header.realBytes = sizeof(Real);
+    header.accumBytes = sizeof(Accum);
+    header.paramsBytes = sizeof(UE::Params<Accum>);
+    header.maxDimensions = maxDimensions_;
+    header.currentDimension = snapshot->positions.dimensions();
+    header.mode = getMode();
+    header.vertexCount = count;
+    header.planeStride = snapshot->positions.stride();
+    header.simulationTime = getSimulationTime();
+
+    return std::async(std::launch::async, [snapshot, path, options] {
+        try {
+            UE::writeCheckpoint(path, snapshot->header, {
+                std::as_bytes(std::span<const UE::Params<Accum>>(&snapshot->params, 1)),
+                std::as_bytes(std::as_const(snapshot->positions).planes()),
+                std::as_bytes(std::as_const(snapshot->momenta).planes()),
+                std::as_bytes(std::span<const Real>(snapshot->spins.vector())),
+                std::as_bytes(std::span<const Real>(snapshot->amplitudes.vector()))}, options);
+            LOG_DEBUG_CAT("Simulation", "Checkpoint written: path={}", std::source_location::current(), path);
+        } catch (const std::exception& e) {
+            LOG_ERROR_CAT("Simulation", "saveCheckpoint failed: {}", std::source_location::current(), e.what());
+            throw;
+        }
+    });
+}
+
+template<typename Real, typename Accum>
+std::unique_ptr<UniversalEquationT<Real, Accum>> UniversalEquationT<Real, Accum>::loadCheckpoint(
+    const std::string& path, const UE::VertexStorage& storage, bool verify) {
+    LOG_INFO_CAT("Simulation", "Loading checkpoint: path={}", std::source_location::current(), path);
+    const UE::CheckpointFile file(path);
+    const UE::CheckpointHeader& header = file.header();
+    if (header.realBytes != sizeof(Real) || header.accumBytes != sizeof(Accum) ||
+        header.paramsBytes != sizeof(UE::Params<Accum>)) {
+        LOG_ERROR_CAT("Simulation", "Checkpoint precision mismatch: realBytes={}, accumBytes={}, expected {} and {}",
+                      std::source_location::current(), header.realBytes, header.accumBytes, sizeof(Real),
+                      sizeof(Accum));
+        throw std::runtime_error("Checkpoint was written with a different precision");
+    }
+    const uint64_t count = header.vertexCount;
+    const int dims = header.currentDimension;
+    const size_t planeBytes = header.planeStride * static_cast<size_t>(std::max(dims, 0)) * sizeof(Real);
+    if (count == 0 || dims < 1 || dims > header.maxDimensions ||
+        header.planeStride != UE::VertexStore<Real>::paddedStride(count) ||
+        header.sections[UE::kCheckpointParams].rawBytes != sizeof(UE::Params<Accum>) ||
+        header.sections[UE::kCheckpointPositions].rawBytes != planeBytes ||
+        header.sections[UE::kCheckpointMomenta].rawBytes != planeBytes ||
+        header.sections[UE::kCheckpointSpins].rawBytes != count * sizeof(Real) ||
+        header.sections[UE::kCheckpointAmplitudes].rawBytes != count * sizeof(Real)) {
+        LOG_ERROR_CAT("Simulation", "Inconsistent checkpoint layout: vertices={}, dimension={}, planeStride={}",
+                      std::source_location::current(), count, dims, header.planeStride);
+        throw std::runtime_error("Checkpoint section sizes do not match its header");
+    }
+    if (verify) {
+        file.verify();
+    }
+
+    UE::Params<Accum> params;
+    file.read(UE::kCheckpointParams, std::as_writable_bytes(std::span<UE::Params<Accum>>(&params, 1)));
+    std::unique_ptr<UniversalEquationT> ue(new UniversalEquationT(DeferInitialization{}, params, header.maxDimensions,
+                                                                  header.mode, false, count, storage));
+    // Uncompressed planes are used in place; compressed ones are decompressed in parallel chunks
+    const auto loadPlanes = [&](UE::CheckpointSection section) {
+        if (!file.compressed()) {
+            return UE::VertexStore<Real>::fromFile(path, header.sections[section].offset, count, dims, storage);
+        }
+        UE::VertexStore<Real> store(count, dims, storage);
+        file.read(section, std::as_writable_bytes(store.planes()));
+        return store;
+    };
+    ue->nCubeVertices_ = loadPlanes(UE::kCheckpointPositions);
+    ue->vertexMomenta_ = loadPlanes(UE::kCheckpointMomenta);
+    ue->vertexSpins_.resize(count);
+    ue->vertexWaveAmplitudes_.resize(count);
+    file.read(UE::kCheckpointSpins, std::as_writable_bytes(std::span<Real>(ue->vertexSpins_.mutate())));
+    file.read(UE::kCheckpointAmplitudes, std::as_writable_bytes(std::span<Real>(ue->vertexWaveAmplitudes_.mutate())));
+
+    ue->currentDimension_.store(dims);
+    ue->simulationTime_.store(static_cast<float>(header.simulationTime));
+    ue->setTotalCharge(static_cast<Accum>(count) * (Accum(1) / count));
+    for (int i = 0; i <= ue->getMaxDimensions(); ++i) {
+        ue->cachedCos_[i] = std::cos(ue->getOmega() * i);
+    }
+    ue->projectedVerts_.resize(count, glm::vec3(0.0f, 0.0f, 0.0f));
+    ue->interactions_.resize(count);
+    ue->interactions_.setVectorPotentialDims(std::min(3, dims));
+    ue->markDirty(kDirtyStructure);
+    ue->updateInteractions();
+    ue->validateProjectedVertices();
+    LOG_INFO_CAT("Simulation", "Checkpoint loaded: vertices={}, dimension={}, simulationTime={}, mapped={}",
+                 std::source_location::current(), count, dims, header.simulationTime, !file.compressed());
+    return ue;
+}
+
+template<typename Real, typename Accum>
+UE::DimensionData UniversalEquationT<Real, Accum>::updateCache() {
+    LOG_INFO_CAT("Simulation", "Updating cache", std::source_location::current());
+    const UE::DimensionData data = toDimensionData(getCurrentDimension(), compute());
     if (getCurrentDimension() > 0 && static_cast<size_t>(getCurrentDimension()) <= dimensionData_.size()) {
         dimensionData_[getCurrentDimension() - 1] = data;
     } else {
@@ -1218,9 +2440,10 @@ UE::DimensionData UniversalEquation::updateCache() {
     return data;
 }
 
-long double UniversalEquation::computeGodWaveAmplitude(int vertexIndex, long double time) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::computeGodWaveAmplitude(int vertexIndex, Accum time) const {
     validateVertexIndex(vertexIndex);
-    long double result = getGodWaveFreq() * vertexWaveAmplitudes_[vertexIndex] * std::cos(getGodWaveFreq() * time);
+    Accum result = getGodWaveFreq() * vertexWaveAmplitudes_[vertexIndex] * std::cos(getGodWaveFreq() * time);
     if (debug_.load()) {
         LOG_DEBUG_CAT("Simulation", "Computed God wave amplitude for vertex {} at time {}: result={}",
                       std::source_location::current(), vertexIndex, time, result);
@@ -1228,211 +2451,353 @@ long double UniversalEquation::computeGodWaveAmplitude(int vertexIndex, long dou
     return result;
 }
 
-const std::vector<long double>& UniversalEquation::getNCubeVertex(int vertexIndex) const {
+template<typename Real, typename Accum>
+typename UE::VertexStore<Real>::ConstVertexView UniversalEquationT<Real, Accum>::getNCubeVertex(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
     return nCubeVertices_[vertexIndex];
 }
 
-const std::vector<long double>& UniversalEquation::getVertexMomentum(int vertexIndex) const {
+template<typename Real, typename Accum>
+typename UE::VertexStore<Real>::ConstVertexView UniversalEquationT<Real, Accum>::getVertexMomentum(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
     return vertexMomenta_[vertexIndex];
 }
 
-long double UniversalEquation::getVertexSpin(int vertexIndex) const {
+template<typename Real, typename Accum>
+Real UniversalEquationT<Real, Accum>::getVertexSpin(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
     return vertexSpins_[vertexIndex];
 }
 
-long double UniversalEquation::getVertexWaveAmplitude(int vertexIndex) const {
+template<typename Real, typename Accum>
+Real UniversalEquationT<Real, Accum>::getVertexWaveAmplitude(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
     return vertexWaveAmplitudes_[vertexIndex];
 }
 
-const glm::vec3& UniversalEquation::getProjectedVertex(int vertexIndex) const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getVertexPotential(int vertexIndex) const {
+    validateVertexIndex(vertexIndex);
+    const auto& mean = energyScratch_.vertexMean;
+    return static_cast<size_t>(vertexIndex) < mean.size() ? mean[vertexIndex] : Accum(0);
+}
+
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getVertexPotentialError(int vertexIndex) const {
+    validateVertexIndex(vertexIndex);
+    const auto& m2 = energyScratch_.vertexM2;
+    const int rounds = energySums_.potentialRounds;
+    if (static_cast<size_t>(vertexIndex) >= m2.size() || rounds < 2) {
+        return Accum(0);
+    }
+    return std::sqrt(m2[vertexIndex] / static_cast<Accum>(rounds - 1) / static_cast<Accum>(rounds));
+}
+
+template<typename Real, typename Accum>
+const glm::vec3& UniversalEquationT<Real, Accum>::getProjectedVertex(int vertexIndex) const {
     validateVertexIndex(vertexIndex);
     return projectedVerts_[vertexIndex];
 }
 
-int UniversalEquation::getCurrentDimension() const {
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getCurrentDimension() const {
     return currentDimension_.load();
 }
 
-int UniversalEquation::getMode() const {
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getMode() const {
     return mode_.load();
 }
 
-bool UniversalEquation::getDebug() const {
+template<typename Real, typename Accum>
+bool UniversalEquationT<Real, Accum>::getDebug() const {
     return debug_.load();
 }
 
-uint64_t UniversalEquation::getMaxVertices() const {
+template<typename Real, typename Accum>
+uint64_t UniversalEquationT<Real, Accum>::getMaxVertices() const {
     return maxVertices_;
 }
 
-int UniversalEquation::getMaxDimensions() const {
+template<typename Real, typename Accum>
+const UE::VertexStorage& UniversalEquationT<Real, Accum>::getVertexStorage() const {
+    return vertexStorage_;
+}
+
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getMaxDimensions() const {
     return maxDimensions_;
 }
 
-long double UniversalEquation::getGodWaveFreq() const {
-    return godWaveFreq_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getGodWaveFreq() const {
+    return getParams()->godWaveFreq;
 }
 
-long double UniversalEquation::getInfluence() const {
-    return influence_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getInfluence() const {
+    return getParams()->influence;
 }
 
-long double UniversalEquation::getWeak() const {
-    return weak_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getWeak() const {
+    return getParams()->weak;
 }
 
-long double UniversalEquation::getCollapse() const {
-    return collapse_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getCollapse() const {
+    return getParams()->collapse;
 }
 
-long double UniversalEquation::getTwoD() const {
-    return twoD_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getTwoD() const {
+    return getParams()->twoD;
 }
 
-long double UniversalEquation::getThreeDInfluence() const {
-    return threeDInfluence_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getThreeDInfluence() const {
+    return getParams()->threeDInfluence;
 }
 
-long double UniversalEquation::getOneDPermeation() const {
-    return oneDPermeation_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getOneDPermeation() const {
+    return getParams()->oneDPermeation;
 }
 
-long double UniversalEquation::getNurbMatterStrength() const {
-    return nurbMatterStrength_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getNurbMatterStrength() const {
+    return getParams()->nurbMatterStrength;
 }
 
-long double UniversalEquation::getNurbEnergyStrength() const {
-    return nurbEnergyStrength_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getNurbEnergyStrength() const {
+    return getParams()->nurbEnergyStrength;
 }
 
-long double UniversalEquation::getAlpha() const {
-    return alpha_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getAlpha() const {
+    return getParams()->alpha;
 }
 
-long double UniversalEquation::getBeta() const {
-    return beta_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getBeta() const {
+    return getParams()->beta;
 }
 
-long double UniversalEquation::getCarrollFactor() const {
-    return carrollFactor_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getCarrollFactor() const {
+    return getParams()->carrollFactor;
 }
 
-long double UniversalEquation::getMeanFieldApprox() const {
-    return meanFieldApprox_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getMeanFieldApprox() const {
+    return getParams()->meanFieldApprox;
 }
 
-long double UniversalEquation::getAsymCollapse() const {
-    return asymCollapse_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getAsymCollapse() const {
+    return getParams()->asymCollapse;
 }
 
-long double UniversalEquation::getPerspectiveTrans() const {
-    return perspectiveTrans_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getPerspectiveTrans() const {
+    return getParams()->perspectiveTrans;
 }
 
-long double UniversalEquation::getPerspectiveFocal() const {
-    return perspectiveFocal_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getPerspectiveFocal() const {
+    return getParams()->perspectiveFocal;
 }
 
-long double UniversalEquation::getSpinInteraction() const {
-    return spinInteraction_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getSpinInteraction() const {
+    return getParams()->spinInteraction;
 }
 
-long double UniversalEquation::getEMFieldStrength() const {
-    return emFieldStrength_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getEMFieldStrength() const {
+    return getParams()->emFieldStrength;
 }
 
-long double UniversalEquation::getRenormFactor() const {
-    return renormFactor_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getRenormFactor() const {
+    return getParams()->renormFactor;
 }
 
-long double UniversalEquation::getVacuumEnergy() const {
-    return vacuumEnergy_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getVacuumEnergy() const {
+    return getParams()->vacuumEnergy;
 }
 
-bool UniversalEquation::getNeedsUpdate() const {
+template<typename Real, typename Accum>
+UE::GravitySolver UniversalEquationT<Real, Accum>::getGravitySolver() const {
+    return getParams()->gravitySolver;
+}
+
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getOpeningAngle() const {
+    return getParams()->openingAngle;
+}
+
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getMeshGridSize() const {
+    return getParams()->meshGridSize;
+}
+
+template<typename Real, typename Accum>
+UE::Integrator UniversalEquationT<Real, Accum>::getIntegrator() const {
+    return getParams()->integrator;
+}
+
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getPotentialTargetError() const {
+    return getParams()->potentialTargetError;
+}
+
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getPotentialStrata() const {
+    return getParams()->potentialStrata;
+}
+
+template<typename Real, typename Accum>
+int UniversalEquationT<Real, Accum>::getPotentialMaxRounds() const {
+    return getParams()->potentialMaxRounds;
+}
+
+template<typename Real, typename Accum>
+uint64_t UniversalEquationT<Real, Accum>::getPotentialSeed() const {
+    return getParams()->potentialSeed;
+}
+
+template<typename Real, typename Accum>
+bool UniversalEquationT<Real, Accum>::getNeedsUpdate() const {
     return needsUpdate_.load();
 }
 
-long double UniversalEquation::getTotalCharge() const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getTotalCharge() const {
     return totalCharge_.load();
 }
 
-long double UniversalEquation::getAvgProjScale() const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getAvgProjScale() const {
     return avgProjScale_.load();
 }
 
-float UniversalEquation::getSimulationTime() const {
+template<typename Real, typename Accum>
+float UniversalEquationT<Real, Accum>::getSimulationTime() const {
     return simulationTime_.load();
 }
 
-long double UniversalEquation::getMaterialDensity() const {
-    return materialDensity_.load();
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getMaterialDensity() const {
+    return getParams()->materialDensity;
 }
 
-uint64_t UniversalEquation::getCurrentVertices() const {
+template<typename Real, typename Accum>
+uint64_t UniversalEquationT<Real, Accum>::getCurrentVertices() const {
     return currentVertices_.load();
 }
 
-long double UniversalEquation::getOmega() const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getOmega() const {
     return omega_;
 }
 
-long double UniversalEquation::getInvMaxDim() const {
+template<typename Real, typename Accum>
+Accum UniversalEquationT<Real, Accum>::getInvMaxDim() const {
     return invMaxDim_;
 }
 
-const std::vector<std::vector<long double>>& UniversalEquation::getNCubeVertices() const {
+template<typename Real, typename Accum>
+const UE::VertexStore<Real>& UniversalEquationT<Real, Accum>::getNCubeVertices() const {
     return nCubeVertices_;
 }
 
-const std::vector<std::vector<long double>>& UniversalEquation::getVertexMomenta() const {
+template<typename Real, typename Accum>
+const UE::VertexStore<Real>& UniversalEquationT<Real, Accum>::getVertexMomenta() const {
     return vertexMomenta_;
 }
 
-const std::vector<long double>& UniversalEquation::getVertexSpins() const {
-    return vertexSpins_;
+template<typename Real, typename Accum>
+std::span<const Real> UniversalEquationT<Real, Accum>::getNCubePlane(int dimension) const {
+    if (dimension < 0 || dimension >= nCubeVertices_.dimensions()) {
+        LOG_ERROR_CAT("Simulation", "Invalid coordinate plane: dimension={}, planes={}",
+                      std::source_location::current(), dimension, nCubeVertices_.dimensions());
+        throw std::out_of_range("Invalid coordinate plane");
+    }
+    return nCubeVertices_.plane(dimension);
+}
+
+template<typename Real, typename Accum>
+std::span<const Real> UniversalEquationT<Real, Accum>::getMomentumPlane(int dimension) const {
+    if (dimension < 0 || dimension >= vertexMomenta_.dimensions()) {
+        LOG_ERROR_CAT("Simulation", "Invalid momentum plane: dimension={}, planes={}",
+                      std::source_location::current(), dimension, vertexMomenta_.dimensions());
+        throw std::out_of_range("Invalid momentum plane");
+    }
+    return vertexMomenta_.plane(dimension);
+}
+
+template<typename Real, typename Accum>
+const std::vector<Real>& UniversalEquationT<Real, Accum>::getVertexSpins() const {
+    return vertexSpins_.vector();
 }
 
-const std::vector<long double>& UniversalEquation::getVertexWaveAmplitudes() const {
-    return vertexWaveAmplitudes_;
+template<typename Real, typename Accum>
+const std::vector<Real>& UniversalEquationT<Real, Accum>::getVertexWaveAmplitudes() const {
+    return vertexWaveAmplitudes_.vector();
 }
 
-const std::vector<UE::DimensionInteraction>& UniversalEquation::getInteractions() const {
+template<typename Real, typename Accum>
+const UE::InteractionStore<Real>& UniversalEquationT<Real, Accum>::getInteractions() const {
     return interactions_;
 }
 
-const std::vector<glm::vec3>& UniversalEquation::getProjectedVerts() const {
-    return projectedVerts_;
+template<typename Real, typename Accum>
+const std::vector<glm::vec3>& UniversalEquationT<Real, Accum>::getProjectedVerts() const {
+    return projectedVerts_.vector();
 }
 
-const std::vector<long double>& UniversalEquation::getCachedCos() const {
+template<typename Real, typename Accum>
+const std::vector<Accum>& UniversalEquationT<Real, Accum>::getCachedCos() const {
     return cachedCos_;
 }
 
-const std::vector<long double>& UniversalEquation::getNurbMatterControlPoints() const {
+template<typename Real, typename Accum>
+const std::vector<Accum>& UniversalEquationT<Real, Accum>::getNurbMatterControlPoints() const {
     return nurbMatterControlPoints_;
 }
 
-const std::vector<long double>& UniversalEquation::getNurbEnergyControlPoints() const {
+template<typename Real, typename Accum>
+const std::vector<Accum>& UniversalEquationT<Real, Accum>::getNurbEnergyControlPoints() const {
     return nurbEnergyControlPoints_;
 }
 
-const std::vector<long double>& UniversalEquation::getNurbKnots() const {
+template<typename Real, typename Accum>
+const std::vector<Accum>& UniversalEquationT<Real, Accum>::getNurbKnots() const {
     return nurbKnots_;
 }
 
-const std::vector<long double>& UniversalEquation::getNurbWeights() const {
+template<typename Real, typename Accum>
+const std::vector<Accum>& UniversalEquationT<Real, Accum>::getNurbWeights() const {
     return nurbWeights_;
 }
 
-const std::vector<UE::DimensionData>& UniversalEquation::getDimensionData() const {
+template<typename Real, typename Accum>
+const std::vector<UE::DimensionData>& UniversalEquationT<Real, Accum>::getDimensionData() const {
     return dimensionData_;
 }
 
-DimensionalNavigator* UniversalEquation::getNavigator() const {
+template<typename Real, typename Accum>
+DimensionalNavigator* UniversalEquationT<Real, Accum>::getNavigator() const {
     return navigator_;
-}
\ No newline at end of file
+}
+template class UniversalEquationT<long double, long double>;
+template class UniversalEquationT<double, double>;
+template class UniversalEquationT<float, float>;
+template class UniversalEquationT<float, double>;
+
+static_assert(std::is_nothrow_move_constructible_v<UniversalEquationT<double, double>> &&
+              std::is_nothrow_move_assignable_v<UniversalEquationT<double, double>> &&
+              std::is_nothrow_swappable_v<UniversalEquationT<double, double>>);